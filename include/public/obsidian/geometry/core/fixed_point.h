@@ -0,0 +1,184 @@
+#ifndef OBSIDIAN_GEOMETRY_CORE_FIXED_POINT_H
+#define OBSIDIAN_GEOMETRY_CORE_FIXED_POINT_H
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// binary fixed-point scalar: a signed integer counting 2^-FractionBits units.
+// every operation is integer arithmetic with a defined rounding, so results are bit-identical
+// on every compiler and platform, which floating point does not guarantee.
+// it is a regular arithmetic type, usable as T of basic_hex.
+
+namespace geometry::core {
+
+namespace details {
+
+// a * b / 2^shift, rounded to nearest (ties toward +infinity)
+template <int Shift>
+constexpr std::int32_t fixed_multiply(std::int32_t a, std::int32_t b) {
+  auto const product = static_cast<std::int64_t>(a) * b + (std::int64_t{ 1 } << (Shift - 1));
+  return static_cast<std::int32_t>(product >> Shift);
+}
+
+// a * 2^shift / b, truncated toward zero
+template <int Shift>
+constexpr std::int32_t fixed_divide(std::int32_t a, std::int32_t b) {
+  return static_cast<std::int32_t>(static_cast<std::int64_t>(a) * (std::int64_t{ 1 } << Shift) / b);
+}
+
+#if defined(__SIZEOF_INT128__)
+
+// __extension__ keeps -Wpedantic quiet about the non standard type
+__extension__ using int128 = __int128;
+
+template <int Shift>
+constexpr std::int64_t fixed_multiply(std::int64_t a, std::int64_t b) {
+  auto const product = static_cast<int128>(a) * b + (static_cast<int128>(1) << (Shift - 1));
+  return static_cast<std::int64_t>(product >> Shift);
+}
+
+template <int Shift>
+constexpr std::int64_t fixed_divide(std::int64_t a, std::int64_t b) {
+  return static_cast<std::int64_t>(static_cast<int128>(a) * (static_cast<int128>(1) << Shift) / b);
+}
+
+#else
+
+// without a 128 bits integer: the same results from 64 bits halves
+
+template <int Shift>
+constexpr std::int64_t fixed_multiply(std::int64_t a, std::int64_t b) {
+  bool const negative = (a < 0) != (b < 0);
+  auto const ua = a < 0 ? 0 - static_cast<std::uint64_t>(a) : static_cast<std::uint64_t>(a);
+  auto const ub = b < 0 ? 0 - static_cast<std::uint64_t>(b) : static_cast<std::uint64_t>(b);
+
+  // 128 bits product as high:low
+  auto const al = ua & 0xffffffffu, ah = ua >> 32;
+  auto const bl = ub & 0xffffffffu, bh = ub >> 32;
+  auto const middle = (al * bl >> 32) + (ah * bl & 0xffffffffu) + (al * bh & 0xffffffffu);
+  std::uint64_t low = ua * ub;
+  std::uint64_t high = ah * bh + (ah * bl >> 32) + (al * bh >> 32) + (middle >> 32);
+
+  // two's complement of the product, then the same rounding as with __int128
+  if (negative) {
+    low = 0 - low;
+    high = ~high + (low == 0);
+  }
+  auto const half = std::uint64_t{ 1 } << (Shift - 1);
+  high += (low + half < low);
+  low += half;
+  return static_cast<std::int64_t>((high << (64 - Shift)) | (low >> Shift));
+}
+
+template <int Shift>
+constexpr std::int64_t fixed_divide(std::int64_t a, std::int64_t b) {
+  bool const negative = (a < 0) != (b < 0);
+  auto const ua = a < 0 ? 0 - static_cast<std::uint64_t>(a) : static_cast<std::uint64_t>(a);
+  auto const ub = b < 0 ? 0 - static_cast<std::uint64_t>(b) : static_cast<std::uint64_t>(b);
+
+  // long division of ua * 2^shift by ub, one bit at a time
+  std::uint64_t quotient = ua / ub;
+  std::uint64_t remainder = ua % ub;
+  for (int i = 0; i < Shift; ++i) {
+    bool const carry = remainder >> 63;
+    remainder <<= 1;
+    quotient <<= 1;
+    if (carry || remainder >= ub) {
+      remainder -= ub;
+      quotient |= 1;
+    }
+  }
+  return negative ? -static_cast<std::int64_t>(quotient) : static_cast<std::int64_t>(quotient);
+}
+
+#endif
+
+} // namespace details
+
+
+template <std::signed_integral Rep, int FractionBits>
+requires (FractionBits > 0 && FractionBits < static_cast<int>(8 * sizeof(Rep)) - 1)
+class basic_fixed {
+public:
+  using rep = Rep;
+
+  static constexpr int fraction_bits = FractionBits;
+  static constexpr rep one = rep{ 1 } << FractionBits;
+
+  constexpr basic_fixed() = default;
+
+  // integers are exact, so they convert implicitly
+  template <std::integral I>
+  constexpr basic_fixed(I i): m_raw{ static_cast<rep>(static_cast<rep>(i) * one) } {}
+
+  static constexpr basic_fixed from_raw(rep raw) {
+    basic_fixed result;
+    result.m_raw = raw;
+    return result;
+  }
+
+  // nearest fixed value, ties away from zero. only deterministic for constants
+  static constexpr basic_fixed from_double(double d) {
+    auto const scaled = d * static_cast<double>(one);
+    return from_raw(static_cast<rep>(scaled < 0 ? scaled - .5 : scaled + .5));
+  }
+
+  constexpr rep raw() const { return m_raw; }
+
+  // largest integer <= *this
+  constexpr rep floor() const { return m_raw >> FractionBits; }
+  // smallest integer >= *this
+  constexpr rep ceil() const { return -(-m_raw >> FractionBits); }
+  // nearest integer, ties toward +infinity
+  constexpr rep nearest() const { return (m_raw + one / 2) >> FractionBits; }
+
+  constexpr double to_double() const { return static_cast<double>(m_raw) / static_cast<double>(one); }
+  explicit constexpr operator double() const { return to_double(); }
+  explicit constexpr operator float() const { return static_cast<float>(to_double()); }
+
+  constexpr basic_fixed operator+() const { return *this; }
+  constexpr basic_fixed operator-() const { return from_raw(-m_raw); }
+
+  constexpr basic_fixed& operator+=(basic_fixed const& b) { m_raw += b.m_raw; return *this; }
+  constexpr basic_fixed& operator-=(basic_fixed const& b) { m_raw -= b.m_raw; return *this; }
+  constexpr basic_fixed& operator*=(basic_fixed const& b) { m_raw = details::fixed_multiply<FractionBits>(m_raw, b.m_raw); return *this; }
+  constexpr basic_fixed& operator/=(basic_fixed const& b) { m_raw = details::fixed_divide<FractionBits>(m_raw, b.m_raw); return *this; }
+
+  friend constexpr basic_fixed operator+(basic_fixed a, basic_fixed const& b) { return a += b; }
+  friend constexpr basic_fixed operator-(basic_fixed a, basic_fixed const& b) { return a -= b; }
+  friend constexpr basic_fixed operator*(basic_fixed a, basic_fixed const& b) { return a *= b; }
+  friend constexpr basic_fixed operator/(basic_fixed a, basic_fixed const& b) { return a /= b; }
+
+  friend constexpr bool operator==(basic_fixed const&, basic_fixed const&) = default;
+  friend constexpr auto operator<=>(basic_fixed const&, basic_fixed const&) = default;
+
+private:
+  rep m_raw = 0;
+};
+
+// 16 integer bits (-32768 to 32767), precision 1.5e-5
+using q16_16 = basic_fixed<std::int32_t, 16>;
+// 32 integer bits, precision 2.3e-10
+using q32_32 = basic_fixed<std::int64_t, 32>;
+
+static_assert( q16_16{ -3 }.raw() == -3 * 65536, "algorithmic error");
+static_assert( q16_16::from_double(1.5) * 2 == 3, "algorithmic error");
+static_assert( (q16_16{ 3 } / 2).raw() == 3 << 15, "algorithmic error");
+static_assert( (q16_16{ -7 } / 2).floor() == -4 && (q16_16{ -7 } / 2).nearest() == -3, "algorithmic error");
+static_assert( q32_32::from_double(-.75) * q32_32::from_double(.5) == q32_32::from_double(-.375), "algorithmic error");
+static_assert( (q32_32{ 1 } / 3 * 3).raw() == q32_32::one - 1, "algorithmic error");
+static_assert( q32_32::from_double(-2.5).ceil() == -2, "algorithmic error");
+
+} // namespace geometry::core
+
+template <typename Rep, int FractionBits>
+struct std::hash< geometry::core::basic_fixed<Rep, FractionBits> > {
+  size_t operator()(geometry::core::basic_fixed<Rep, FractionBits> const& x) const {
+    return hash<Rep>{}(x.raw());
+  }
+};
+
+#endif
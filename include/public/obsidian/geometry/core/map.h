@@ -2,8 +2,19 @@
 #define OBSIDIAN_GEOMETRY_CORE_MAP_H
 
 #include <obsidian/geometry/core/surface.h>
+#include <obsidian/geometry/core/parallel.h>
 #include <unordered_map>
+#include <memory>
+#include <memory_resource>
+#include <functional>
+#include <vector>
+#include <span>
+#include <algorithm>
 #include <ranges>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <tuple>
 
 namespace geometry::core {
 
@@ -13,14 +24,54 @@ unbound map: map anywhere to some value
 bound map: restricted to a surface
 
 indexed map: support is not point, but some linear index
+dense map: indexed map holding a value for every index of its bounds
+tracked map: indexed map recording which indices changed
+
+every map takes an allocator for its storage. core::pmr aliases use std::pmr::polymorphic_allocator,
+to put short lived maps on an arena or a pool (see memory.h).
 */
 
 
 template <typename Key, typename Value>
+using sparse_map_allocator = std::allocator<std::pair<Key const, Value>>;
+
+namespace details {
+
+inline constexpr std::size_t bulk_chunk = 4096;
+
+// flags[i] = test(i) for every i in [0, count), by fixed chunks shared among threads
+template <typename Test>
+std::vector<std::uint8_t> bulk_flags(std::size_t count, unsigned threads, Test && test) {
+  std::vector<std::uint8_t> flags(count);
+  parallel_for((count + bulk_chunk - 1) / bulk_chunk, threads, [&](std::size_t c) {
+    auto const last = std::min(count, (c + 1) * bulk_chunk);
+    for (std::size_t i = c * bulk_chunk; i < last; ++i) flags[i] = test(i) ? 1 : 0;
+  });
+  return flags;
+}
+
+} // namespace details
+
+/*
+bulk operations: the parallel variants (threads > 1) only share the read only part of the work
+(key conversions, bounds checks, predicates) among threads. the hash table is then updated by the
+caller, in input order, so the result does not depend on the count of threads.
+*/
+
+template <typename Key, typename Value, typename Allocator = sparse_map_allocator<Key, Value>>
 class basic_sparse_map {
 public:
   using key_type = Key;
   using value_type = Value;
+  using allocator_type = Allocator;
+
+private:
+  using container_type = std::unordered_map<key_type, value_type, std::hash<key_type>, std::equal_to<key_type>, allocator_type>;
+
+public:
+  using node_type = typename container_type::node_type;
+
+  allocator_type get_allocator() const { return m_content.get_allocator(); }
 
   auto mappings() const { return std::views::all(m_content); }
   auto mappings() { return std::views::all(m_content); }
@@ -31,12 +82,55 @@ public:
   auto size() const { return m_content.size(); }
   void clear() { m_content.clear(); }
 
+  // room for n entries without rehashing
+  void reserve(std::size_t n) { m_content.reserve(n); }
+
   bool contains(key_type const& k) const {
     return m_content.find(k) != m_content.cend();
   }
 
+  bool erase(key_type const& k) { return m_content.erase(k) != 0; }
+
+  // removes the entries where pred(key, value) holds, returns their count
+  template <typename Pred>
+  std::size_t erase_if(Pred pred, unsigned threads = 1) {
+    if (threads <= 1) {
+      return std::erase_if(m_content, [&](auto const& kv) { return pred(kv.first, std::as_const(kv.second)); });
+    }
+
+    auto const entries = snapshot();
+    auto const flags = details::bulk_flags(entries.size(), threads, [&](std::size_t i) {
+      return pred(entries[i]->first, std::as_const(entries[i]->second));
+    });
+
+    std::size_t erased = 0;
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+      if (flags[i] == 0) continue;
+      m_content.erase(entries[i]);
+      ++erased;
+    }
+    return erased;
+  }
+
+  // the entry of k moves out of the map (empty if none), without copying its value
+  node_type extract(key_type const& k) { return m_content.extract(k); }
+
+  // out[i] = address of the value of keys[i], nullptr if unmapped. out shall hold keys.size() pointers
+  void get_many(std::span<key_type const> keys, std::span<value_type const*> out) const {
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      auto const it = m_content.find(keys[i]);
+      out[i] = it == m_content.end() ? nullptr : &it->second;
+    }
+  }
+
+  // out[i] = contains(keys[i]), out shall hold keys.size() flags
+  void contains_many(std::span<key_type const> keys, std::span<bool> out) const {
+    for (std::size_t i = 0; i < keys.size(); ++i) out[i] = m_content.find(keys[i]) != m_content.end();
+  }
+
 protected:
   basic_sparse_map() = default;
+  explicit basic_sparse_map(allocator_type const& allocator): m_content(allocator) {}
   ~basic_sparse_map() = default;
 
   value_type const* optional(key_type const& p) const {
@@ -58,42 +152,158 @@ protected:
     return v == nullptr ? fallback : *v;
   }
 
+  /*
+  set(key_of(get<0>(e)), get<1>(e)) for every element e of range whose key is valid.
+  keys are checked one by one, not once per batch: no bounds of the library have a cheaper
+  test for a range of keys (points are tested against the surface, indices are one compare),
+  and the check is small next to the hash table insertion. threads only share the checks.
+  */
+  template <typename Range, typename KeyOf, typename Valid>
+  std::size_t insert_range_if(Range && range, KeyOf key_of, Valid valid, unsigned threads) {
+    if constexpr (std::ranges::sized_range<Range>) {
+      m_content.reserve(m_content.size() + static_cast<std::size_t>(std::ranges::size(range)));
+    }
+
+    std::size_t stored = 0;
+    if constexpr (std::ranges::random_access_range<Range> && std::ranges::sized_range<Range>) {
+      if (threads > 1) {
+        auto const first = std::ranges::begin(range);
+        auto const n = static_cast<std::size_t>(std::ranges::size(range));
+        std::vector<key_type> keys(n);
+        auto const flags = details::bulk_flags(n, threads, [&](std::size_t i) {
+          keys[i] = key_of(std::get<0>(first[i]));
+          return valid(keys[i]);
+        });
+
+        for (std::size_t i = 0; i < n; ++i) {
+          if (flags[i] == 0) continue;
+          m_content.insert_or_assign(keys[i], std::get<1>(first[i]));
+          ++stored;
+        }
+        return stored;
+      }
+    }
+
+    for (auto && e : range) {
+      auto const k = key_of(std::get<0>(e));
+      if (!valid(k)) continue;
+      m_content.insert_or_assign(k, std::get<1>(e));
+      ++stored;
+    }
+    return stored;
+  }
+
+  // node is given back when its key is already mapped
+  bool insert_node_if(node_type && node, bool valid) {
+    if (node.empty() || !valid) return false;
+    auto result = m_content.insert(std::move(node));
+    if (!result.inserted) node = std::move(result.node);
+    return result.inserted;
+  }
+
+  /*
+  moves the entries of other with a valid key not in this map yet, the others stay in other.
+  nodes are moved when both allocators are equal, values otherwise.
+  */
+  template <typename Valid>
+  std::size_t merge_if(basic_sparse_map & other, Valid valid, unsigned threads) {
+    auto const entries = other.snapshot();
+    auto const flags = details::bulk_flags(entries.size(), threads, [&](std::size_t i) {
+      auto const& k = entries[i]->first;
+      return valid(k) && !contains(k);
+    });
+
+    bool const same_allocator = get_allocator() == other.get_allocator();
+    std::size_t moved = 0;
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+      if (flags[i] == 0) continue;
+      if (same_allocator) {
+        m_content.insert(other.m_content.extract(entries[i]));
+      } else {
+        m_content.emplace(entries[i]->first, std::move(entries[i]->second));
+        other.m_content.erase(entries[i]);
+      }
+      ++moved;
+    }
+    return moved;
+  }
+
 private:
-  std::unordered_map<key_type, value_type> m_content;
+  // iterators stay valid when other entries are erased or extracted
+  std::vector<typename container_type::iterator> snapshot() {
+    std::vector<typename container_type::iterator> entries;
+    entries.reserve(m_content.size());
+    for (auto it = m_content.begin(); it != m_content.end(); ++it) entries.push_back(it);
+    return entries;
+  }
+
+  container_type m_content;
 };
 
 
 
 // unbound specialization
-template <typename Key, typename Value>
-class sparse_map: public basic_sparse_map<Key, Value> {
+template <typename Key, typename Value, typename Allocator = sparse_map_allocator<Key, Value>>
+class sparse_map: public basic_sparse_map<Key, Value, Allocator> {
 private:
-  using base = basic_sparse_map<Key, Value>;
+  using base = basic_sparse_map<Key, Value, Allocator>;
 
 public:
+  using typename base::allocator_type;
+
+  using typename base::key_type;
+  using typename base::node_type;
+
+  sparse_map() = default;
+  explicit sparse_map(allocator_type const& allocator): base(allocator) {}
+
   using base::optional;
   using base::get;
   using base::set;
   using base::contains;
+
+  // set on every (key, value) pair of range, returns the count of pairs stored
+  template <std::ranges::input_range Range>
+  std::size_t insert_range(Range && range, unsigned threads = 1) {
+    return base::insert_range_if(std::forward<Range>(range), [](key_type const& k) { return k; }, [](key_type const&) { return true; }, threads);
+  }
+
+  // node from extract, left in node if its key is already mapped
+  bool insert(node_type && node) { return base::insert_node_if(std::move(node), true); }
+
+  // moves the entries of other whose key is not mapped here, returns their count
+  std::size_t merge(sparse_map & other, unsigned threads = 1) {
+    return base::merge_if(other, [](key_type const&) { return true; }, threads);
+  }
 };
 
 
-template <typename Bounds, typename Value>
+template <
+  typename Bounds,
+  typename Value,
+  typename Allocator = sparse_map_allocator<typename core::surface_traits<Bounds>::value_type, Value>
+>
 class bounded_sparse_map:
   public basic_sparse_map<
     typename core::surface_traits<Bounds>::value_type,
-    Value
+    Value,
+    Allocator
   > {
 private:
   using traits = surface_traits<Bounds>;
-  using base = basic_sparse_map<typename traits::value_type, Value>;
+  using base = basic_sparse_map<typename traits::value_type, Value, Allocator>;
 
 public:
   using bounds_type = Bounds;
   using typename base::key_type;
   using typename base::value_type;
+  using typename base::allocator_type;
+  using typename base::node_type;
 
-  bounded_sparse_map(bounds_type const& bounds): m_bounds{ bounds } {}
+  bounded_sparse_map(bounds_type const& bounds, allocator_type const& allocator = allocator_type{}):
+    base(allocator),
+    m_bounds{ bounds }
+  {}
 
 
   auto const& bounds() const { return m_bounds; }
@@ -123,6 +333,28 @@ public:
     return is_valid(p) ? base::get(p, fallback) : nullptr;
   }
 
+  // set on every (key, value) pair of range with a valid key, returns the count of pairs stored
+  template <std::ranges::input_range Range>
+  std::size_t insert_range(Range && range, unsigned threads = 1) {
+    return base::insert_range_if(
+      std::forward<Range>(range),
+      [](key_type const& k) { return k; },
+      [this](key_type const& k) { return is_valid(k); },
+      threads
+    );
+  }
+
+  // node from extract, left in node if its key is invalid or already mapped
+  bool insert(node_type && node) {
+    return base::insert_node_if(std::move(node), !node.empty() && is_valid(node.key()));
+  }
+
+  // moves the entries of other whose key is valid and not mapped here, returns their count.
+  // with the same bounds, every key of other is valid
+  std::size_t merge(bounded_sparse_map & other, unsigned threads = 1) {
+    return base::merge_if(other, [this](key_type const& k) { return is_valid(k); }, threads);
+  }
+
 private:
   bounds_type m_bounds;
 };
@@ -134,15 +366,20 @@ conversions between position (indexed_type) and index (index_type)
 limit: operator()(indexed_type)
 
 */
-template <typename IndexedBounds, typename Value>
+template <
+  typename IndexedBounds,
+  typename Value,
+  typename Allocator = sparse_map_allocator<typename core::indexed_surface_traits<IndexedBounds>::index_type, Value>
+>
 class indexed_sparse_map:
   public basic_sparse_map<
     typename core::indexed_surface_traits<IndexedBounds>::index_type,
-    Value
+    Value,
+    Allocator
   > {
 private:
   using traits = core::indexed_surface_traits<IndexedBounds>;
-  using base = basic_sparse_map<typename traits::index_type, Value>;
+  using base = basic_sparse_map<typename traits::index_type, Value, Allocator>;
 
 public:
   using bounds_type = IndexedBounds;
@@ -150,10 +387,15 @@ public:
   using typename base::key_type;
   using index_type = IndexedBounds::index_type;
   using typename base::value_type;
+  using typename base::allocator_type;
+  using typename base::node_type;
 
   static_assert(std::is_same<index_type, key_type>::value, "key should be index");
 
-  indexed_sparse_map(bounds_type const& bounds): m_bounds{ bounds } {}
+  indexed_sparse_map(bounds_type const& bounds, allocator_type const& allocator = allocator_type{}):
+    base(allocator),
+    m_bounds{ bounds }
+  {}
 
 
   auto const& bounds() const { return m_bounds; }
@@ -225,11 +467,381 @@ public:
     return set(index_of(p), value);
   }
 
+  using base::get_many;
+  using base::contains_many;
+
+  // out[i] = optional(positions[i])
+  void get_many(std::span<indexed_type const> positions, std::span<value_type const*> out) const {
+    for (std::size_t i = 0; i < positions.size(); ++i) out[i] = optional(positions[i]);
+  }
+
+  // out[i] = contains(positions[i])
+  void contains_many(std::span<indexed_type const> positions, std::span<bool> out) const {
+    for (std::size_t i = 0; i < positions.size(); ++i) out[i] = contains(positions[i]);
+  }
+
+  using base::erase;
+
+  bool erase(indexed_type const& p) {
+    return erase(index_of(p));
+  }
+
+  using base::extract;
+
+  node_type extract(indexed_type const& p) {
+    return extract(index_of(p));
+  }
+
+  // set on every (key, value) pair of range with a valid key, keys being indices or positions.
+  // returns the count of pairs stored
+  template <std::ranges::input_range Range>
+  std::size_t insert_range(Range && range, unsigned threads = 1) {
+    using key = std::remove_cvref_t<std::tuple_element_t<0, std::remove_cvref_t<std::ranges::range_reference_t<Range>>>>;
+    return base::insert_range_if(
+      std::forward<Range>(range),
+      [this](key const& k) -> key_type {
+        if constexpr (std::is_convertible_v<key, key_type>) return k;
+        else return index_of(k);
+      },
+      [this](key_type const& k) { return is_valid(k); },
+      threads
+    );
+  }
+
+  // node from extract, left in node if its key is invalid or already mapped
+  bool insert(node_type && node) {
+    return base::insert_node_if(std::move(node), !node.empty() && is_valid(node.key()));
+  }
+
+  // moves the entries of other whose index is valid and not mapped here, returns their count.
+  // with the same bounds, every index of other is valid
+  std::size_t merge(indexed_sparse_map & other, unsigned threads = 1) {
+    return base::merge_if(other, [this](key_type const& k) { return is_valid(k); }, threads);
+  }
+
+private:
+  bounds_type m_bounds;
+};
+
+
+/*
+dense counterpart of indexed_sparse_map: every index of the bounds holds a value,
+values are stored contiguously in index order (values()[i] is the value at index i).
+*/
+template <typename IndexedBounds, typename Value, typename Allocator = std::allocator<Value>>
+class indexed_dense_map {
+private:
+  using traits = core::indexed_surface_traits<IndexedBounds>;
+
+public:
+  using bounds_type = IndexedBounds;
+  using indexed_type = typename IndexedBounds::value_type;
+  using index_type = typename traits::index_type;
+  using key_type = index_type;
+  using value_type = Value;
+  using allocator_type = Allocator;
+
+  indexed_dense_map(
+    bounds_type const& bounds,
+    value_type const& fill = value_type{},
+    allocator_type const& allocator = allocator_type{}
+  ):
+    m_bounds{ bounds },
+    m_content(traits::size(bounds), fill, allocator)
+  {}
+
+  allocator_type get_allocator() const { return m_content.get_allocator(); }
+
+
+  auto const& bounds() const { return m_bounds; }
+
+  auto area() const { return traits::size(bounds()); }
+  auto size() const { return m_content.size(); }
+
+  auto indices() const { return traits::indices(bounds()); }
+  auto positions() const {
+    return indices() | std::views::transform(
+      [this](index_type i){ return traits::value_at(this->m_bounds, i); }
+    ); }
+
+  std::span<value_type const> values() const { return m_content; }
+  std::span<value_type> values() { return m_content; }
+
+  void fill(value_type const& value) { std::ranges::fill(m_content, value); }
+
+  bool is_valid(key_type const& i) const {
+    return traits::is_valid(bounds(), i);
+  }
+
+  // unchecked access
+  value_type const& operator[](key_type i) const { return m_content[i]; }
+  value_type& operator[](key_type i) { return m_content[i]; }
+
+  value_type const* optional(key_type const& i) const {
+    return is_valid(i) ? &m_content[i] : nullptr;
+  }
+
+  value_type* optional(key_type const& i) {
+    return is_valid(i) ? &m_content[i] : nullptr;
+  }
+
+  value_type* set(key_type const& i, value_type const& value) {
+    if (!is_valid(i)) return nullptr;
+    return &(m_content[i] = value);
+  }
+
+  value_type const& get(key_type const& i, value_type const& fallback) const {
+    return is_valid(i) ? m_content[i] : fallback;
+  }
+
+
+
+  auto position_at(index_type i) const {
+    return traits::value_at(bounds(), i);
+  }
+
+  auto index_of(indexed_type const& p) const {
+    return traits::index_of(bounds(), p);
+  }
+
+  bool is_valid(indexed_type const& p) const {
+    return is_valid(index_of(p));
+  }
+
+  value_type const* optional(indexed_type const& p) const {
+    return optional(index_of(p));
+  }
+
+  value_type* optional(indexed_type const& p) {
+    return optional(index_of(p));
+  }
+
+  value_type const& get(indexed_type const& p, value_type const& fallback) const {
+    return get(index_of(p), fallback);
+  }
+
+  // out[i] = optional(indices[i])
+  void get_many(std::span<key_type const> indices, std::span<value_type const*> out) const {
+    for (std::size_t i = 0; i < indices.size(); ++i) out[i] = optional(indices[i]);
+  }
+
+  // out[i] = optional(positions[i])
+  void get_many(std::span<indexed_type const> positions, std::span<value_type const*> out) const {
+    for (std::size_t i = 0; i < positions.size(); ++i) out[i] = optional(positions[i]);
+  }
+
+  // out[i] = is_valid(indices[i]): every valid cell of a dense map holds a value
+  void contains_many(std::span<key_type const> indices, std::span<bool> out) const {
+    for (std::size_t i = 0; i < indices.size(); ++i) out[i] = is_valid(indices[i]);
+  }
+
+  // out[i] = is_valid(positions[i])
+  void contains_many(std::span<indexed_type const> positions, std::span<bool> out) const {
+    for (std::size_t i = 0; i < positions.size(); ++i) out[i] = is_valid(positions[i]);
+  }
+
+  value_type* set(indexed_type const& p, value_type const& value) {
+    return set(index_of(p), value);
+  }
+
 private:
   bounds_type m_bounds;
+  std::vector<value_type, allocator_type> m_content;
+};
+
+
+/*
+indices changed since the last drain.
+a bit per index, and a bit per chunk of 64 words (4096 indices) set when any index of it is:
+marking and draining cost O(1) per change, region queries skip clean chunks at once.
+*/
+class dirty_tracker {
+public:
+  static constexpr std::size_t word_bits = 64;
+  static constexpr std::size_t chunk_size = word_bits * word_bits;
+
+  explicit dirty_tracker(std::size_t size = 0):
+    m_size{ size },
+    m_words((size + word_bits - 1) / word_bits, 0),
+    m_chunks((m_words.size() + word_bits - 1) / word_bits, 0)
+  {}
+
+  std::size_t size() const { return m_size; }
+
+  // count of drains so far
+  std::size_t epoch() const { return m_epoch; }
+
+  bool any() const { return !m_list.empty(); }
+  std::size_t count() const { return m_list.size(); }
+
+  // changed indices, in order of first change
+  std::span<std::size_t const> changed() const { return m_list; }
+
+  bool is_dirty(std::size_t i) const {
+    return i < m_size && ((m_words[i / word_bits] >> (i % word_bits)) & 1u) != 0;
+  }
+
+  void mark(std::size_t i) {
+    if (i >= m_size) return;
+    auto & word = m_words[i / word_bits];
+    auto const bit = std::uint64_t{ 1 } << (i % word_bits);
+    if (word & bit) return;
+    word |= bit;
+    m_chunks[i / chunk_size] |= std::uint64_t{ 1 } << ((i / word_bits) % word_bits);
+    m_list.push_back(i);
+  }
+
+  // true if any index in [first, last) changed
+  bool any_in(std::size_t first, std::size_t last) const {
+    last = std::min(last, m_size);
+    while (first < last) {
+      auto const word = first / word_bits;
+      // whole clean chunk
+      if (first % chunk_size == 0 && last - first >= chunk_size && m_chunks[first / chunk_size] == 0) {
+        first += chunk_size;
+        continue;
+      }
+      auto const begin_bit = first % word_bits;
+      auto const end_bit = std::min<std::size_t>(word_bits, begin_bit + (last - first));
+      auto mask = ~std::uint64_t{ 0 } << begin_bit;
+      if (end_bit < word_bits) mask &= (std::uint64_t{ 1 } << end_bit) - 1;
+      if (m_words[word] & mask) return true;
+      first += end_bit - begin_bit;
+    }
+    return false;
+  }
+
+  /*
+  starts a new epoch, then calls f(index) for every index changed in the previous one,
+  in order of first change. f may mark indices (again): they are changes of the new epoch.
+  */
+  template <typename F>
+  void drain(F && f) {
+    std::vector<std::size_t> list;
+    list.swap(m_list);
+    // every set bit is listed, so whole words and chunks clear
+    for (auto const i : list) {
+      m_words[i / word_bits] = 0;
+      m_chunks[i / chunk_size] = 0;
+    }
+    ++m_epoch;
+    for (auto const i : list) f(i);
+    // keeps the capacity when f marked nothing
+    if (m_list.empty()) {
+      list.clear();
+      m_list.swap(list);
+    }
+  }
+
+  std::vector<std::size_t> drain() {
+    std::vector<std::size_t> result;
+    result.reserve(m_list.size());
+    drain([&result](std::size_t i) { result.push_back(i); });
+    return result;
+  }
+
+private:
+  std::size_t m_size;
+  std::size_t m_epoch = 0;
+  std::vector<std::uint64_t> m_words;
+  std::vector<std::uint64_t> m_chunks;
+  std::vector<std::size_t> m_list;
 };
 
 
+/*
+opt-in change tracking over an indexed map (indexed_sparse_map or indexed_dense_map).
+the map is only reachable as const: writes go through set, modify or touch, which mark the index.
+*/
+template <typename IndexedMap>
+class tracked_map {
+public:
+  using map_type = IndexedMap;
+  using bounds_type = typename map_type::bounds_type;
+  using indexed_type = typename map_type::indexed_type;
+  using key_type = typename map_type::key_type;
+  using value_type = typename map_type::value_type;
+
+  explicit tracked_map(map_type map):
+    m_map{ std::move(map) },
+    m_dirty{ static_cast<std::size_t>(m_map.area()) }
+  {}
+
+  map_type const& map() const { return m_map; }
+  auto const& bounds() const { return m_map.bounds(); }
+  dirty_tracker const& dirty() const { return m_dirty; }
+
+  decltype(auto) get(key_type const& i, value_type const& fallback) const { return m_map.get(i, fallback); }
+  decltype(auto) get(indexed_type const& p, value_type const& fallback) const { return m_map.get(p, fallback); }
+  value_type const* optional(key_type const& i) const { return m_map.optional(i); }
+  value_type const* optional(indexed_type const& p) const { return m_map.optional(p); }
+
+  value_type* set(key_type const& i, value_type const& value) {
+    auto const result = m_map.set(i, value);
+    if (result != nullptr) m_dirty.mark(i);
+    return result;
+  }
+
+  value_type* set(indexed_type const& p, value_type const& value) {
+    return set(m_map.index_of(p), value);
+  }
+
+  // calls f(value &) on an existing value, returns false if there is none
+  template <typename F>
+  bool modify(key_type const& i, F && f) {
+    auto const v = m_map.optional(i);
+    if (v == nullptr) return false;
+    f(*v);
+    m_dirty.mark(i);
+    return true;
+  }
+
+  template <typename F>
+  bool modify(indexed_type const& p, F && f) { return modify(m_map.index_of(p), std::forward<F>(f)); }
+
+  // sparse maps: removes every value, marking their indices
+  void clear() requires requires (map_type & m) { m.keys(); m.clear(); } {
+    for (auto const i : m_map.keys()) m_dirty.mark(i);
+    m_map.clear();
+  }
+
+  // records a change made another way
+  void touch(key_type const& i) { m_dirty.mark(i); }
+  void touch(indexed_type const& p) { m_dirty.mark(m_map.index_of(p)); }
+
+  bool changed(key_type const& i) const { return m_dirty.is_dirty(i); }
+  bool changed_in(key_type first, key_type last) const { return m_dirty.any_in(first, last); }
+
+  // f may set, modify or touch: those changes show in the next drain
+  template <typename F>
+  void drain_dirty(F && f) { m_dirty.drain(std::forward<F>(f)); }
+  std::vector<std::size_t> drain_dirty() { return m_dirty.drain(); }
+
+private:
+  map_type m_map;
+  dirty_tracker m_dirty;
+};
+
+
+// maps on a std::pmr::memory_resource, as std::pmr does for the standard containers
+namespace pmr {
+
+template <typename Key, typename Value>
+using sparse_map = core::sparse_map<Key, Value,
+  std::pmr::polymorphic_allocator<std::pair<Key const, Value>>>;
+
+template <typename Bounds, typename Value>
+using bounded_sparse_map = core::bounded_sparse_map<Bounds, Value,
+  std::pmr::polymorphic_allocator<std::pair<typename surface_traits<Bounds>::value_type const, Value>>>;
+
+template <typename IndexedBounds, typename Value>
+using indexed_sparse_map = core::indexed_sparse_map<IndexedBounds, Value,
+  std::pmr::polymorphic_allocator<std::pair<typename indexed_surface_traits<IndexedBounds>::index_type const, Value>>>;
+
+template <typename IndexedBounds, typename Value>
+using indexed_dense_map = core::indexed_dense_map<IndexedBounds, Value, std::pmr::polymorphic_allocator<Value>>;
+
+} // namespace pmr
 
 } // namespace geometry::core
 
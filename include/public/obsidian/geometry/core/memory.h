@@ -0,0 +1,69 @@
+#ifndef OBSIDIAN_GEOMETRY_CORE_MEMORY_H
+#define OBSIDIAN_GEOMETRY_CORE_MEMORY_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+// memory resources for the core::pmr maps (see map.h).
+// a map of n entries costs about n + 1 allocations with the default allocator:
+// building and dropping many short lived maps is mostly malloc work.
+
+namespace geometry::core {
+
+/*
+monotonic arena: allocations bump a pointer in an owned buffer (then in upstream blocks of
+growing size), deallocations do nothing, reset() releases everything at once.
+meant for scratch maps of a frame or a tick: allocate them all, use them, drop them, reset.
+maps using it shall be destroyed before the arena is reset or destroyed.
+not thread safe.
+*/
+class arena: public std::pmr::memory_resource {
+public:
+  explicit arena(std::size_t initial_bytes = 64 * 1024, std::pmr::memory_resource * upstream = std::pmr::get_default_resource()):
+    m_buffer{ std::make_unique<std::byte[]>(initial_bytes) },
+    m_size{ initial_bytes },
+    m_resource{ m_buffer.get(), m_size, upstream }
+  {}
+
+  arena(arena const&) = delete;
+  arena& operator=(arena const&) = delete;
+
+  // frees the upstream blocks, the owned buffer is reused
+  void reset() { m_resource.release(); }
+
+  std::pmr::memory_resource * resource() { return this; }
+
+private:
+  void * do_allocate(std::size_t bytes, std::size_t alignment) override {
+    return m_resource.allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void * p, std::size_t bytes, std::size_t alignment) override {
+    m_resource.deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+    return this == &other;
+  }
+
+  std::unique_ptr<std::byte[]> m_buffer;
+  std::size_t m_size;
+  std::pmr::monotonic_buffer_resource m_resource;
+};
+
+
+/*
+pool of the calling thread: freed nodes go to per size free lists and are reused by the next maps,
+so a map built and dropped on every tick stops reaching malloc after the first one.
+memory is only returned upstream when the thread exits.
+a map on it shall be used and destroyed by the thread which built it.
+*/
+inline std::pmr::memory_resource * thread_node_pool() {
+  thread_local std::pmr::unsynchronized_pool_resource pool;
+  return &pool;
+}
+
+} // namespace geometry::core
+
+#endif
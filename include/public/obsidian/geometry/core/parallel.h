@@ -0,0 +1,42 @@
+#ifndef OBSIDIAN_GEOMETRY_CORE_PARALLEL_H
+#define OBSIDIAN_GEOMETRY_CORE_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace geometry::core {
+
+// minimal work sharing used by the parallel variants of the algorithms.
+// results shall be written per task (not per thread) so that they do not depend on scheduling.
+
+inline unsigned default_concurrency() {
+  auto const n = std::thread::hardware_concurrency();
+  return n == 0 ? 1 : n;
+}
+
+// runs task(i) for every i in [0, count) on up to `threads` threads, the caller being one of them.
+template <typename Task>
+void parallel_for(std::size_t count, unsigned threads, Task && task) {
+  auto const workers = static_cast<std::size_t>(std::min<std::size_t>(threads, count));
+  if (workers <= 1) {
+    for (std::size_t i = 0; i < count; ++i) task(i);
+    return;
+  }
+
+  std::atomic<std::size_t> next{ 0 };
+  auto work = [&]() {
+    for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) task(i);
+  };
+
+  std::vector<std::jthread> pool;
+  pool.reserve(workers - 1);
+  for (std::size_t t = 1; t < workers; ++t) pool.emplace_back(work);
+  work();
+}
+
+} // namespace geometry::core
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef OBSIDIAN_GEOMETRY_CORE_SAMPLING_H
+#define OBSIDIAN_GEOMETRY_CORE_SAMPLING_H
+
+#include <obsidian/geometry/core/surface.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+// random draws of distinct indices, without retrying already drawn ones.
+// std distributions are implementation defined, so numbers are built from the raw
+// engine output: a seeded std::mt19937 or std::mt19937_64 gives the same draws everywhere.
+
+namespace geometry::core {
+
+namespace details {
+
+// 64 random bits from an engine giving 32 or 64 bits per call
+template <typename URBG>
+std::uint64_t random_word(URBG & g) {
+  constexpr auto range = static_cast<std::uint64_t>(URBG::max() - URBG::min());
+  static_assert(
+    range == std::numeric_limits<std::uint64_t>::max() || range == std::numeric_limits<std::uint32_t>::max(),
+    "engines shall give 32 or 64 random bits"
+  );
+  if constexpr (range == std::numeric_limits<std::uint64_t>::max()) {
+    return static_cast<std::uint64_t>(g() - URBG::min());
+  } else {
+    auto const high = static_cast<std::uint64_t>(g() - URBG::min());
+    auto const low = static_cast<std::uint64_t>(g() - URBG::min());
+    return (high << 32) | low;
+  }
+}
+
+// uniform in [0, n), n > 0. words below 2^64 mod n are rejected to remove the modulo bias
+template <typename URBG>
+std::uint64_t random_below(URBG & g, std::uint64_t n) {
+  auto const threshold = (0 - n) % n;
+  for (;;) {
+    auto const word = random_word(g);
+    if (word >= threshold) return word % n;
+  }
+}
+
+// uniform in (0, 1)
+template <typename URBG>
+double random_unit(URBG & g) {
+  return (static_cast<double>(random_word(g) >> 11) + .5) * 0x1p-53;
+}
+
+} // namespace details
+
+
+/*
+k distinct indices among [0, n), sorted (all of them if k >= n).
+small samples use Floyd's algorithm, in O(k) draws and memory;
+large ones a partial Fisher-Yates shuffle of [0, n).
+*/
+template <typename Index = std::size_t, typename URBG>
+std::vector<Index> sample_indices(Index n, Index k, URBG & g) {
+  k = std::min(k, n);
+  std::vector<Index> result;
+  result.reserve(k);
+
+  if (k < n / 8) {
+    std::unordered_set<Index> drawn;
+    drawn.reserve(k);
+    for (Index j = n - k; j < n; ++j) {
+      auto const t = static_cast<Index>(details::random_below(g, static_cast<std::uint64_t>(j) + 1));
+      auto const picked = drawn.contains(t) ? j : t;
+      drawn.insert(picked);
+      result.push_back(picked);
+    }
+  } else {
+    std::vector<Index> all(n);
+    std::iota(all.begin(), all.end(), Index{ 0 });
+    for (Index i = 0; i < k; ++i) {
+      auto const j = i + static_cast<Index>(details::random_below(g, static_cast<std::uint64_t>(n - i)));
+      std::swap(all[i], all[j]);
+    }
+    result.assign(all.begin(), all.begin() + static_cast<std::ptrdiff_t>(k));
+  }
+
+  std::ranges::sort(result);
+  return result;
+}
+
+// k distinct values of an indexed surface, by increasing index
+template <typename IndexedSurface, typename URBG>
+std::vector<typename indexed_surface_traits<IndexedSurface>::value_type>
+sample(IndexedSurface const& surface, std::size_t k, URBG & g) {
+  using traits = indexed_surface_traits<IndexedSurface>;
+  using index_type = typename traits::index_type;
+
+  std::vector<typename traits::value_type> result;
+  auto const indices = sample_indices<index_type>(traits::size(surface), static_cast<index_type>(k), g);
+  result.reserve(indices.size());
+  for (auto const i : indices) result.push_back(traits::value_at(surface, i));
+  return result;
+}
+
+/*
+k distinct indices among [0, weights.size()), index i being drawn with a probability
+proportional to weights[i] at each draw, sorted. null or negative weights are never drawn.
+each index gets the key log(u)/w (Efraimidis-Spirakis), the k largest keys are kept: O(n).
+*/
+template <typename Index = std::size_t, typename URBG>
+std::vector<Index> weighted_sample_indices(std::span<double const> weights, std::size_t k, URBG & g) {
+  struct keyed { double key; Index index; };
+  std::vector<keyed> keys;
+  keys.reserve(weights.size());
+  for (std::size_t i = 0; i < weights.size(); ++i) {
+    auto const u = details::random_unit(g);
+    if (weights[i] > 0) keys.push_back({ std::log(u) / weights[i], static_cast<Index>(i) });
+  }
+
+  k = std::min(k, keys.size());
+  auto const by_key = [](keyed const& a, keyed const& b) { return a.key > b.key; };
+  std::ranges::nth_element(keys, keys.begin() + static_cast<std::ptrdiff_t>(k), by_key);
+
+  std::vector<Index> result;
+  result.reserve(k);
+  for (std::size_t i = 0; i < k; ++i) result.push_back(keys[i].index);
+  std::ranges::sort(result);
+  return result;
+}
+
+} // namespace geometry::core
+
+#endif
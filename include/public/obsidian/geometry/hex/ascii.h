@@ -0,0 +1,83 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_ASCII_H
+#define OBSIDIAN_GEOMETRY_HEX_ASCII_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/disk.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <string>
+
+/*
+flat top disks drawn as text, every cell being
+
+   +-----+
+  /       \
+ + label   +
+  \       /
+   +-----+
+
+the picture is laid out in one buffer: a cell is placed from its coordinates,
+columns going 8 chars right with q and cells 4 lines up with r (2 lines with q).
+*/
+
+namespace geometry::hex {
+
+// chars of a cell label
+inline constexpr std::size_t ascii_slot = 9;
+
+// chars of a line (newline included) and count of lines of the picture of a disk
+constexpr std::size_t ascii_line_size(disk_radius radius) { return 16 * std::size_t(radius) + 12; }
+constexpr std::size_t ascii_lines(disk_radius radius) { return 8 * std::size_t(radius) + 5; }
+constexpr std::size_t ascii_size(disk_radius radius) { return ascii_line_size(radius) * ascii_lines(radius); }
+
+/*
+draws the disk of given radius into buffer, of ascii_size(radius) chars.
+formatter(point, std::span<char, ascii_slot>) writes the label of each cell into its slot,
+which is filled with spaces beforehand. lines are of fixed width, padded with spaces.
+*/
+template <typename T = integers::base_type, typename Formatter>
+void render_ascii(std::span<char> buffer, disk_radius radius, Formatter && formatter) {
+  if (buffer.size() < ascii_size(radius)) return;
+
+  auto const line_size = ascii_line_size(radius);
+  auto const lines = ascii_lines(radius);
+  std::fill_n(buffer.data(), ascii_size(radius), ' ');
+  for (std::size_t y = 0; y < lines; ++y) buffer[y * line_size + line_size - 1] = '\n';
+
+  auto const put = [&](std::size_t x, std::size_t y, char const* text) {
+    for (auto * out = buffer.data() + y * line_size + x; *text; ++text, ++out) *out = *text;
+  };
+
+  auto const R = static_cast<T>(radius);
+  for (T q = -R; q <= R; ++q) {
+    for (T r = std::max(-R, -q - R); r <= std::min(R, -q + R); ++r) {
+      // left corner of the label line
+      auto const x = static_cast<std::size_t>(8 * (q + R));
+      auto const y = static_cast<std::size_t>(4 * R - 4 * r - 2 * q + 2);
+
+      put(x + 2, y - 2, "+-----+");
+      put(x + 1, y - 1, "/");
+      put(x + 9, y - 1, "\\");
+      put(x, y, "+");
+      put(x + 10, y, "+");
+      put(x + 1, y + 1, "\\");
+      put(x + 9, y + 1, "/");
+      put(x + 2, y + 2, "+-----+");
+
+      formatter(basic_point<T>{q, r}, std::span<char, ascii_slot>(buffer.data() + y * line_size + x + 1, ascii_slot));
+    }
+  }
+}
+
+template <typename T = integers::base_type, typename Formatter>
+std::string render_ascii(disk_radius radius, Formatter && formatter) {
+  std::string result(ascii_size(radius), ' ');
+  render_ascii<T>(result, radius, formatter);
+  return result;
+}
+
+} // namespace geometry::hex
+
+#endif
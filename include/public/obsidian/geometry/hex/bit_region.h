@@ -0,0 +1,325 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_BIT_REGION_H
+#define OBSIDIAN_GEOMETRY_HEX_BIT_REGION_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/rows.h>
+#include <obsidian/geometry/hex/region.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// see https://www.redblobgames.com/grids/hexagons/#map-storage (parallelogram maps)
+
+/*
+dense sets of cells as bits, in a parallelogram layout: a row of bits per r, q along it,
+rows padded to whole 64 bits words. a neighbor offset <dq, dr> is then a shift of the rows by dr
+and of the bits by dq, so a morphology step handles 64 cells per word operation.
+
+a disk of radius k is the sum of 3 segments of k steps (a, b, c in [0, k] give all its cells):
+  a*<1,-1> + b*<0,1> + c*<-1,0> = <a - c, b - a>
+dilating by a segment of k steps takes log2(k) doublings, so dilating by radius k costs
+3*log2(k) shifted ors of the whole set instead of k rounds of 6 neighbors.
+*/
+
+namespace geometry::hex {
+
+namespace details {
+
+// 64 bits of words starting at bit pos, bits out of words being 0
+inline std::uint64_t bits_at(std::span<std::uint64_t const> words, std::ptrdiff_t pos) {
+  auto const word = [&](std::ptrdiff_t w) {
+    return w < 0 || w >= static_cast<std::ptrdiff_t>(words.size()) ? std::uint64_t{ 0 } : words[static_cast<std::size_t>(w)];
+  };
+  auto const w = pos >= 0 ? pos / 64 : -((63 - pos) / 64);
+  auto const b = static_cast<unsigned>(pos - 64 * w);
+  return b == 0 ? word(w) : (word(w) >> b) | (word(w + 1) << (64 - b));
+}
+
+// dst bit i |= src bit (i - shift), for every bit of dst
+inline void or_shifted_bits(std::span<std::uint64_t> dst, std::span<std::uint64_t const> src, std::ptrdiff_t shift) {
+  for (std::size_t w = 0; w < dst.size(); ++w) {
+    dst[w] |= bits_at(src, 64 * static_cast<std::ptrdiff_t>(w) - shift);
+  }
+}
+
+// rows of bits, bit i of row y being cell <q_begin + i, r_begin + y>
+template <typename T>
+struct bit_rows {
+  T q_begin = 0, r_begin = 0;
+  std::size_t width = 0, height = 0, words = 0;
+  std::vector<std::uint64_t> bits;
+
+  bit_rows() = default;
+  bit_rows(T q, T r, std::size_t w, std::size_t h):
+    q_begin{ q }, r_begin{ r }, width{ w }, height{ h }, words{ (w + 63) / 64 }, bits(words * h) {}
+
+  std::span<std::uint64_t> row(std::size_t y) { return { bits.data() + y * words, words }; }
+  std::span<std::uint64_t const> row(std::size_t y) const { return { bits.data() + y * words, words }; }
+
+  // clears the padding bits past width
+  void trim() {
+    if (width % 64 == 0) return;
+    auto const mask = (std::uint64_t{ 1 } << (width % 64)) - 1;
+    for (std::size_t y = 0; y < height; ++y) row(y)[words - 1] &= mask;
+  }
+
+  // row y |= row (y - dr) of source, shifted by dq bits
+  void or_shifted(bit_rows const& source, std::ptrdiff_t dq, std::ptrdiff_t dr) {
+    for (std::size_t y = 0; y < height; ++y) {
+      auto const sy = static_cast<std::ptrdiff_t>(y) - dr;
+      if (sy < 0 || sy >= static_cast<std::ptrdiff_t>(height)) continue;
+      or_shifted_bits(row(y), source.row(static_cast<std::size_t>(sy)), dq);
+    }
+  }
+};
+
+// rows |= rows + disk of radius k, the rows having a margin of k cells on every side
+template <typename T>
+void dilate_padded(bit_rows<T> & rows, T k) {
+  constexpr std::array<std::array<std::ptrdiff_t, 2>, 3> segments{{ {1, -1}, {0, 1}, {-1, 0} }};
+
+  bit_rows<T> copy;
+  for (auto const& [dq, dr] : segments) {
+    // rows hold the sum with the segment of steps [0, length)
+    for (T length = 1; length <= k;) {
+      auto const step = std::min(length, static_cast<T>(k + 1 - length));
+      copy = rows;
+      rows.or_shifted(copy, dq * step, dr * step);
+      length += step;
+    }
+  }
+  rows.trim();
+}
+
+} // namespace details
+
+
+template <typename T>
+class basic_bit_region {
+public:
+  using value_type = basic_point<T>;
+  using region_type = basic_region<T>;
+
+  // empty set of the cells of bounds, on the parallelogram holding them
+  explicit basic_bit_region(region_type const& bounds) {
+    auto const runs = bounds.runs();
+    if (runs.empty()) return;
+    T q_min = runs.front().q_begin, q_max = runs.front().q_end;
+    for (auto const& run : runs) {
+      q_min = std::min(q_min, run.q_begin);
+      q_max = std::max(q_max, run.q_end);
+    }
+    auto const r_min = runs.front().r, r_max = runs.back().r;
+
+    m_bits = { q_min, r_min, static_cast<std::size_t>(q_max - q_min), static_cast<std::size_t>(r_max - r_min + 1) };
+    m_mask = m_bits;
+    fill_runs(m_mask, runs);
+  }
+
+  // cells of both bounds and cells
+  basic_bit_region(region_type const& bounds, region_type const& cells): basic_bit_region(bounds) {
+    assign(cells);
+  }
+
+
+  // cells out of bounds are ignored
+  void assign(region_type const& cells) {
+    std::ranges::fill(m_bits.bits, 0);
+    fill_runs(m_bits, cells.runs());
+    apply_mask();
+  }
+
+  void clear() { std::ranges::fill(m_bits.bits, 0); }
+
+  // true if p is in bounds and set
+  bool contains(value_type const& p) const {
+    std::size_t y, i;
+    return locate(p, y, i) && ((m_bits.row(y)[i / 64] >> (i % 64)) & 1u);
+  }
+
+  bool is_valid(value_type const& p) const {
+    std::size_t y, i;
+    return locate(p, y, i) && ((m_mask.row(y)[i / 64] >> (i % 64)) & 1u);
+  }
+
+  // false if p is out of bounds
+  bool set(value_type const& p, bool value = true) {
+    std::size_t y, i;
+    if (!locate(p, y, i) || !((m_mask.row(y)[i / 64] >> (i % 64)) & 1u)) return false;
+    auto & word = m_bits.row(y)[i / 64];
+    auto const bit = std::uint64_t{ 1 } << (i % 64);
+    word = value ? (word | bit) : (word & ~bit);
+    return true;
+  }
+
+  bool reset(value_type const& p) { return set(p, false); }
+
+  // count of set cells
+  std::size_t count() const {
+    std::size_t result = 0;
+    for (auto const word : m_bits.bits) result += static_cast<std::size_t>(std::popcount(word));
+    return result;
+  }
+
+  bool empty() const { return std::ranges::all_of(m_bits.bits, [](std::uint64_t w) { return w == 0; }); }
+
+  // f(cell) for every set cell, by increasing r then q
+  template <typename F>
+  void for_each(F && f) const {
+    for (std::size_t y = 0; y < m_bits.height; ++y) {
+      auto const row = m_bits.row(y);
+      for (std::size_t w = 0; w < row.size(); ++w) {
+        for (auto word = row[w]; word != 0; word &= word - 1) {
+          auto const i = 64 * w + static_cast<std::size_t>(std::countr_zero(word));
+          f(value_type{ static_cast<T>(m_bits.q_begin + static_cast<T>(i)), static_cast<T>(m_bits.r_begin + static_cast<T>(y)) });
+        }
+      }
+    }
+  }
+
+  std::vector<value_type> points() const {
+    std::vector<value_type> result;
+    result.reserve(count());
+    for_each([&](value_type const& p) { result.push_back(p); });
+    return result;
+  }
+
+  // set cells as runs, a word at a time
+  region_type to_region() const { return to_region(m_bits); }
+  region_type bounds() const { return to_region(m_mask); }
+
+
+  // morphology: out of bounds cells are never set, so erosion also eats from the bounds edges
+
+  // adds the cells at distance <= k of a set cell
+  void dilate(T k = 1) { morph(k, false); }
+  // keeps the cells whose cells at distance <= k are all set
+  void erode(T k = 1) { morph(k, true); }
+  void open(T k = 1) { erode(k); dilate(k); }
+  void close(T k = 1) { dilate(k); erode(k); }
+
+
+  // boolean operations, both operands sharing the same bounds
+  basic_bit_region& operator|=(basic_bit_region const& b) { combine(b, [](auto x, auto y) { return x | y; }); return *this; }
+  basic_bit_region& operator&=(basic_bit_region const& b) { combine(b, [](auto x, auto y) { return x & y; }); return *this; }
+  basic_bit_region& operator-=(basic_bit_region const& b) { combine(b, [](auto x, auto y) { return x & ~y; }); return *this; }
+  basic_bit_region& operator^=(basic_bit_region const& b) { combine(b, [](auto x, auto y) { return x ^ y; }); return *this; }
+
+  friend basic_bit_region operator|(basic_bit_region a, basic_bit_region const& b) { return a |= b; }
+  friend basic_bit_region operator&(basic_bit_region a, basic_bit_region const& b) { return a &= b; }
+  friend basic_bit_region operator-(basic_bit_region a, basic_bit_region const& b) { return a -= b; }
+  friend basic_bit_region operator^(basic_bit_region a, basic_bit_region const& b) { return a ^= b; }
+
+  friend bool operator==(basic_bit_region const& a, basic_bit_region const& b) { return a.m_bits.bits == b.m_bits.bits; }
+
+private:
+  bool locate(value_type const& p, std::size_t & y, std::size_t & i) const {
+    auto const dq = static_cast<std::ptrdiff_t>(p.q() - m_bits.q_begin);
+    auto const dr = static_cast<std::ptrdiff_t>(p.r() - m_bits.r_begin);
+    if (dq < 0 || dr < 0 || dq >= static_cast<std::ptrdiff_t>(m_bits.width) || dr >= static_cast<std::ptrdiff_t>(m_bits.height)) return false;
+    y = static_cast<std::size_t>(dr);
+    i = static_cast<std::size_t>(dq);
+    return true;
+  }
+
+  static void fill_runs(details::bit_rows<T> & rows, std::span<basic_row_run<T> const> runs) {
+    for (auto const& run : runs) {
+      auto const y = static_cast<std::ptrdiff_t>(run.r - rows.r_begin);
+      if (y < 0 || y >= static_cast<std::ptrdiff_t>(rows.height)) continue;
+      auto const first = std::max<std::ptrdiff_t>(0, run.q_begin - rows.q_begin);
+      auto const last = std::min<std::ptrdiff_t>(static_cast<std::ptrdiff_t>(rows.width), run.q_end - rows.q_begin);
+      auto const row = rows.row(static_cast<std::size_t>(y));
+      for (auto i = first; i < last;) {
+        auto const w = static_cast<std::size_t>(i / 64);
+        auto const b = static_cast<unsigned>(i % 64);
+        auto const n = std::min<std::ptrdiff_t>(last - i, 64 - b);
+        auto const ones = n == 64 ? ~std::uint64_t{ 0 } : ((std::uint64_t{ 1 } << n) - 1);
+        row[w] |= ones << b;
+        i += n;
+      }
+    }
+  }
+
+  static region_type to_region(details::bit_rows<T> const& rows) {
+    std::vector<basic_row_run<T>> runs;
+    for (std::size_t y = 0; y < rows.height; ++y) {
+      auto const row = rows.row(y);
+      auto const r = static_cast<T>(rows.r_begin + static_cast<T>(y));
+
+      // first bit from i equal to !flip, a word at a time
+      auto const find = [&](std::size_t i, std::uint64_t flip) {
+        while (i < rows.width) {
+          auto const word = (row[i / 64] ^ flip) >> (i % 64);
+          if (word != 0) return std::min(rows.width, i + static_cast<std::size_t>(std::countr_zero(word)));
+          i += 64 - i % 64;
+        }
+        return rows.width;
+      };
+
+      for (std::size_t i = find(0, 0); i < rows.width; i = find(i, 0)) {
+        auto const begin = i;
+        i = find(begin, ~std::uint64_t{ 0 });
+        runs.push_back({ r, static_cast<T>(rows.q_begin + static_cast<T>(begin)), static_cast<T>(rows.q_begin + static_cast<T>(i)) });
+      }
+    }
+    return region_type{ std::move(runs) };
+  }
+
+  void apply_mask() {
+    for (std::size_t w = 0; w < m_bits.bits.size(); ++w) m_bits.bits[w] &= m_mask.bits[w];
+  }
+
+  template <typename Op>
+  void combine(basic_bit_region const& b, Op op) {
+    for (std::size_t w = 0; w < m_bits.bits.size(); ++w) m_bits.bits[w] = op(m_bits.bits[w], b.m_bits.bits[w]);
+    apply_mask();
+  }
+
+  // dilation of the set, or of its complement for an erosion, on rows with a margin of k cells
+  void morph(T k, bool complement) {
+    if (k <= 0 || m_bits.height == 0) return;
+
+    auto const margin = static_cast<std::size_t>(k);
+    details::bit_rows<T> padded{
+      static_cast<T>(m_bits.q_begin - k), static_cast<T>(m_bits.r_begin - k),
+      m_bits.width + 2 * margin, m_bits.height + 2 * margin
+    };
+    for (std::size_t y = 0; y < m_bits.height; ++y) {
+      details::or_shifted_bits(padded.row(y + margin), m_bits.row(y), static_cast<std::ptrdiff_t>(k));
+    }
+    if (complement) {
+      for (auto & word : padded.bits) word = ~word;
+      padded.trim();
+    }
+
+    details::dilate_padded(padded, k);
+
+    for (std::size_t y = 0; y < m_bits.height; ++y) {
+      auto const row = m_bits.row(y);
+      std::ranges::fill(row, 0);
+      details::or_shifted_bits(row, padded.row(y + margin), -static_cast<std::ptrdiff_t>(k));
+      if (complement) {
+        for (auto & word : row) word = ~word;
+      }
+    }
+    m_bits.trim();
+    apply_mask();
+  }
+
+  details::bit_rows<T> m_bits;
+  details::bit_rows<T> m_mask;
+};
+
+
+namespace integers {
+using bit_region = basic_bit_region<base_type>;
+}
+
+} // namespace geometry::hex
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_COMPONENTS_H
+#define OBSIDIAN_GEOMETRY_HEX_COMPONENTS_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/neighbor.h>
+#include <obsidian/geometry/hex/offset.h>
+#include <obsidian/geometry/core/surface.h>
+#include <obsidian/geometry/core/map.h>
+#include <obsidian/geometry/core/parallel.h>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+
+// connected component labeling over indexed surfaces, with six-connectivity.
+// every array is dense and in index order of the surface: no hashing involved.
+
+namespace geometry::hex {
+
+// one connected region: its cell count, its smallest index and its q/r/s bounds
+template <typename Index, typename T>
+struct component {
+  Index size = 0;
+  Index first = 0;
+  T q_min, q_max;
+  T r_min, r_max;
+  T s_min, s_max;
+};
+
+template <typename Index, typename T>
+struct component_labels {
+  std::vector<Index> labels; // component of each index, in [0, components.size())
+  std::vector<component<Index, T>> components; // ordered by their smallest index
+};
+
+
+namespace details {
+
+// union-find over indices, the root of a set being its smallest index
+template <typename Index>
+class index_forest {
+public:
+  explicit index_forest(Index size): m_parent(size) {
+    for (Index i = 0; i < size; ++i) m_parent[i] = i;
+  }
+
+  // path halving
+  Index find(Index i) {
+    while (m_parent[i] != i) {
+      m_parent[i] = m_parent[m_parent[i]];
+      i = m_parent[i];
+    }
+    return i;
+  }
+
+  // without compression, safe to call concurrently once unions are done
+  Index root(Index i) const {
+    while (m_parent[i] != i) i = m_parent[i];
+    return i;
+  }
+
+  void unite(Index a, Index b) {
+    a = find(a);
+    b = find(b);
+    if (a < b) m_parent[b] = a;
+    else if (b < a) m_parent[a] = b;
+  }
+
+private:
+  std::vector<Index> m_parent;
+};
+
+} // namespace details
+
+
+/*
+labels the components of values (values[i] being the value at index i of bounds).
+two adjacent cells belong to the same component when connected(a, b) holds.
+
+with several threads, index tiles are labeled independently, then tiles are
+merged along the edges crossing their borders.
+*/
+template <typename Bounds, typename Value, typename Connected = std::equal_to<>>
+auto label_components(
+  Bounds const& bounds,
+  std::span<Value const> values,
+  Connected connected = {},
+  unsigned threads = 1
+) {
+  using traits = core::indexed_surface_traits<Bounds>;
+  using index_type = typename traits::index_type;
+  using coordinate_type = typename traits::value_type::value_type;
+  using result_type = component_labels<index_type, coordinate_type>;
+
+  index_type const size = traits::size(bounds);
+  details::index_forest<index_type> forest{ size };
+
+  // first pass: union with the preceding neighbors inside the tile, keep the others for merging
+  std::size_t const tiles = threads <= 1 ? 1 : 4 * static_cast<std::size_t>(threads);
+  std::vector<std::vector<std::pair<index_type, index_type>>> borders(tiles);
+
+  std::array<basic_vector<coordinate_type>, 6> steps;
+  for (auto const n : neighborhoods) steps[static_cast<int>(n)] = neighbor_vector<coordinate_type>(n);
+
+  core::parallel_for(tiles, threads, [&](std::size_t t) {
+    index_type const first = size * t / tiles;
+    index_type const last = size * (t + 1) / tiles;
+    for (index_type i = first; i < last; ++i) {
+      auto const p = traits::value_at(bounds, i);
+      for (auto const& step : steps) {
+        auto const j = traits::index_of(bounds, p + step);
+        if (j >= i || !traits::is_valid(bounds, j) || !connected(values[i], values[j])) continue;
+        if (j >= first) forest.unite(i, j);
+        else borders[t].emplace_back(i, j);
+      }
+    }
+  });
+
+  for (auto const& border : borders) {
+    for (auto const& [i, j] : border) forest.unite(i, j);
+  }
+
+  // second pass: resolve roots, then number them in index order
+  result_type result;
+  result.labels.resize(size);
+  core::parallel_for(tiles, threads, [&](std::size_t t) {
+    for (index_type i = size * t / tiles; i < size * (t + 1) / tiles; ++i) result.labels[i] = forest.root(i);
+  });
+
+  for (index_type i = 0; i < size; ++i) {
+    auto const p = traits::value_at(bounds, i);
+    auto const root = result.labels[i];
+    if (root == i) {
+      result.labels[i] = static_cast<index_type>(result.components.size());
+      result.components.push_back({0, i, p.q(), p.q(), p.r(), p.r(), p.s(), p.s()});
+    } else {
+      // roots are smallest indices, so they are already numbered
+      result.labels[i] = result.labels[root];
+    }
+
+    auto & c = result.components[result.labels[i]];
+    ++c.size;
+    c.q_min = std::min(c.q_min, p.q()); c.q_max = std::max(c.q_max, p.q());
+    c.r_min = std::min(c.r_min, p.r()); c.r_max = std::max(c.r_max, p.r());
+    c.s_min = std::min(c.s_min, p.s()); c.s_max = std::max(c.s_max, p.s());
+  }
+
+  return result;
+}
+
+template <typename Bounds, typename Value, typename Allocator, typename Connected = std::equal_to<>>
+auto label_components(
+  core::indexed_dense_map<Bounds, Value, Allocator> const& map,
+  Connected connected = {},
+  unsigned threads = 1
+) {
+  return label_components(map.bounds(), map.values(), connected, threads);
+}
+
+template <typename T, typename Value, typename Connected = std::equal_to<>>
+auto label_components(
+  basic_offset_map_view<T, Value> const& view,
+  Connected connected = {},
+  unsigned threads = 1
+) {
+  return label_components(view.bounds(), std::span<Value const>{ view.values() }, connected, threads);
+}
+
+} // namespace geometry::hex
+
+#endif
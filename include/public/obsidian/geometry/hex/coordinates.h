@@ -196,13 +196,26 @@ constexpr basic_vector<T> operator-(basic_point<T> const& a, basic_point<T> cons
 // distance measures are complex notion. here is "cell hops" distance
 
 
+namespace details {
+template <typename T>
+constexpr T absolute(T x) { return x < 0 ? -x : x; }
+
+template <typename T>
+constexpr T maximum(T a, T b) { return a < b ? b : a; }
+}
+
+// max(|q|, |r|, |s|): the largest signed component is not enough (<1,1> has length 2)
 template <typename T>
 constexpr auto length(basic_vector<T> const& v) {
-  return (v.q() > v.r()) ?
-    (v.q() > v.s() ? v.q() : v.s()):
-    (v.r() > v.s() ? v.r() : v.s());
+  return details::maximum(
+    details::maximum(details::absolute(v.q()), details::absolute(v.r())),
+    details::absolute(v.s())
+  );
 }
 
+static_assert( length(basic_vector<int>{1,1}) == 2, "algorithmic error");
+static_assert( length(basic_vector<int>{-2,1}) == 2, "algorithmic error");
+
 
 template <typename T>
 constexpr auto distance(basic_point<T> const& a, basic_point<T> const& b) { return length(b - a); }
@@ -3,10 +3,17 @@
 
 #include <obsidian/geometry/hex/coordinates.h>
 #include <obsidian/geometry/hex/neighbor.h>
+#include <obsidian/geometry/hex/rows.h>
 
 #include <vector>
 #include <ranges>
 #include <iterator>
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <span>
+#include <type_traits>
 
 // see https://www.redblobgames.com/grids/hexagons/
 // and https://www.redblobgames.com/grids/hexagons/implementation.html
@@ -58,6 +65,22 @@ constexpr disk_index disk_size(disk_radius radius) {
 
 constexpr disk_index disk_end_index(disk_radius radius) { return disk_size(radius); }
 
+// radius of the ring holding a disk index: disk_size(radius-1) <= index < disk_size(radius)
+constexpr disk_radius ring_radius_of(disk_index index) {
+  if (index == 0) return 0;
+  // no floating point square root at compile time
+  if (std::is_constant_evaluated()) {
+    disk_radius radius = 0;
+    while (disk_size(radius) <= index) ++radius;
+    return radius;
+  }
+  // 3r² + 3r + 1 > index, estimated with floating point then fixed
+  auto radius = static_cast<disk_radius>((3. + std::sqrt(12. * static_cast<double>(index) - 3.)) / 6.);
+  while (radius > 0 && disk_size(radius - 1) > index) --radius;
+  while (disk_size(radius) <= index) ++radius;
+  return radius;
+}
+
 namespace details {
 
 constexpr auto ring_index_range(ring_radius radius) {
@@ -84,6 +107,13 @@ constexpr basic_vector<T> vector_in_ring(ring_radius radius, ring_index i) {
 
 template <typename T>
 constexpr basic_vector<T> vector_in_disk(disk_radius radius, disk_index index) {
+  if (!std::is_constant_evaluated()) {
+    // direct ring lookup instead of walking rings
+    if (index >= disk_size(radius)) return zero<T>;
+    auto const ring = ring_radius_of(index);
+    return ring == 0 ? zero<T> : vector_in_ring<T>(ring, index - disk_size(ring - 1));
+  }
+
   for (disk_radius r = 0; r <= radius; ++r) {
     disk_index const size = ring_size(r);
     if (index < size) {
@@ -130,24 +160,371 @@ constexpr disk_index disk_index_of(basic_vector<T> const& v) {
 static_assert( vector_in_disk<int>(3, 10) == basic_vector<int>{-1,2}, "algorithmic error");
 static_assert( disk_index_of(basic_vector<int>{-1,2}) == 10, "algorithmic error");
 
+/*
+row-major layout: rows by increasing r, then cells by increasing q.
+row r holds 2R+1-|r| cells. the layout is symmetric around the center:
+the cell at index i is the opposite of the one at size-1-i.
+*/
+
+constexpr disk_index disk_row_size(disk_radius radius, long long r) {
+  auto const R = static_cast<long long>(radius);
+  return r < -R || r > R ? 0 : static_cast<disk_index>(2 * R + 1 - (r < 0 ? -r : r));
+}
+
+// cells in the rows below r
+constexpr disk_index disk_row_offset(disk_radius radius, long long r) {
+  auto const R = static_cast<long long>(radius);
+  if (r <= -R) return 0;
+  if (r > R) return disk_size(radius);
+  if (r > 0) return disk_size(radius) - disk_row_offset(radius, -r) - disk_row_size(radius, r);
+  // sum of R+1+t for t in [0, n)
+  auto const n = r + R;
+  return static_cast<disk_index>(n * (R + 1) + n * (n - 1) / 2);
+}
+
+template <typename T>
+constexpr disk_index row_major_index_of(disk_radius radius, basic_vector<T> const& v) {
+  if (static_cast<disk_radius>(length(v)) > radius) return disk_size(radius);
+  auto const R = static_cast<long long>(radius);
+  auto const r = static_cast<long long>(v.r());
+  auto const q_begin = r < 0 ? -R - r : -R;
+  return disk_row_offset(radius, r) + static_cast<disk_index>(static_cast<long long>(v.q()) - q_begin);
+}
+
+template <typename T>
+constexpr basic_vector<T> vector_in_rows(disk_radius radius, disk_index index) {
+  auto const size = disk_size(radius);
+  if (index >= size) return zero<T>;
+  // upper half mirrors the lower one
+  if (index > size / 2) return -vector_in_rows<T>(radius, size - 1 - index);
+
+  // n(R+1) + n(n-1)/2 <= index, estimated with floating point then fixed
+  auto const R = static_cast<long long>(radius);
+  long long n = 0;
+  if (!std::is_constant_evaluated()) {
+    auto const b = static_cast<double>(R) + .5;
+    n = static_cast<long long>(std::sqrt(b * b + 2. * static_cast<double>(index)) - b);
+    while (n > 0 && disk_row_offset(radius, n - R) > index) --n;
+  }
+  while (disk_row_offset(radius, n + 1 - R) <= index) ++n;
+
+  auto const r = n - R;
+  auto const q = -R - r + static_cast<long long>(index - disk_row_offset(radius, r));
+  return { static_cast<T>(q), static_cast<T>(r) };
+}
+
+static_assert( disk_row_offset(2, 0) == 7 && disk_row_offset(2, 1) == 12, "algorithmic error");
+static_assert( row_major_index_of(2, basic_vector<int>{0,0}) == 9, "algorithmic error");
+static_assert( row_major_index_of(2, basic_vector<int>{-1,2}) == 17, "algorithmic error");
+static_assert( vector_in_rows<int>(2, 17) == basic_vector<int>{-1,2}, "algorithmic error");
+static_assert( vector_in_rows<int>(3, 4) == basic_vector<int>{-1,-2}, "algorithmic error");
+
+} // namespace details
+
+namespace details {
+
+// segment s of a ring goes along direction s+2
+template <typename T>
+inline constexpr std::array<basic_vector<T>, 6> segment_steps{
+  neighbor_vector<T>(neighborhood::i + 2),
+  neighbor_vector<T>(neighborhood::i + 3),
+  neighbor_vector<T>(neighborhood::i + 4),
+  neighbor_vector<T>(neighborhood::i + 5),
+  neighbor_vector<T>(neighborhood::i + 6),
+  neighbor_vector<T>(neighborhood::i + 7),
+};
+
 } // namespace details
 
+/*
+walks a ring in index order: each step adds the direction of the current segment,
+without the division of vector_in_ring. jumps use the closed form.
+values are center + offset, center being a point or the zero vector.
+*/
+template <typename T, bool Vector = false>
+class ring_iterator {
+public:
+  using value_type = basic_hex<T, Vector>;
+  using difference_type = std::ptrdiff_t;
+  using iterator_concept = std::random_access_iterator_tag;
+  using iterator_category = std::input_iterator_tag;
+
+  constexpr ring_iterator() = default;
+  constexpr ring_iterator(value_type const& center, ring_radius radius, ring_index index)
+    : m_center{ center }, m_radius{ radius } { jump(index); }
+
+  constexpr value_type operator*() const { return m_center + m_offset; }
+  constexpr value_type operator[](difference_type n) const { return *(*this + n); }
+
+  constexpr ring_index index() const { return m_index; }
+
+  constexpr ring_iterator & operator++() {
+    ++m_index;
+    if (m_radius == 0) return *this;
+    m_offset = m_offset + details::segment_steps<T>[m_segment];
+    if (++m_step == m_radius) {
+      m_step = 0;
+      ++m_segment;
+    }
+    return *this;
+  }
+
+  constexpr ring_iterator & operator--() {
+    --m_index;
+    if (m_radius == 0) return *this;
+    if (m_step == 0) {
+      --m_segment;
+      m_step = m_radius;
+    }
+    --m_step;
+    m_offset = m_offset - details::segment_steps<T>[m_segment];
+    return *this;
+  }
+
+  constexpr ring_iterator operator++(int) { auto copy = *this; ++*this; return copy; }
+  constexpr ring_iterator operator--(int) { auto copy = *this; --*this; return copy; }
+
+  constexpr ring_iterator & operator+=(difference_type n) { jump(m_index + n); return *this; }
+  constexpr ring_iterator & operator-=(difference_type n) { jump(m_index - n); return *this; }
+
+  friend constexpr ring_iterator operator+(ring_iterator it, difference_type n) { return it += n; }
+  friend constexpr ring_iterator operator+(difference_type n, ring_iterator it) { return it += n; }
+  friend constexpr ring_iterator operator-(ring_iterator it, difference_type n) { return it -= n; }
+  friend constexpr difference_type operator-(ring_iterator const& a, ring_iterator const& b) {
+    return static_cast<difference_type>(a.m_index) - static_cast<difference_type>(b.m_index);
+  }
+
+  friend constexpr bool operator==(ring_iterator const& a, ring_iterator const& b) { return a.m_index == b.m_index; }
+  friend constexpr auto operator<=>(ring_iterator const& a, ring_iterator const& b) { return a.m_index <=> b.m_index; }
+
+private:
+  constexpr void jump(ring_index index) {
+    m_index = index;
+    if (m_radius == 0) return;
+    // the end is one full turn from the start
+    m_segment = index / m_radius;
+    m_step = index % m_radius;
+    m_offset = details::vector_in_ring<T>(m_radius, index % ring_size(m_radius));
+  }
+
+  value_type m_center{};
+  basic_vector<T> m_offset{};
+  ring_radius m_radius = 0;
+  ring_index m_index = 0;
+  ring_index m_segment = 0;
+  ring_index m_step = 0;
+};
+
+/*
+walks a disk in spiral index order, ring after ring.
+a ring ends back on its start k*i, the next one starts one step further along i.
+*/
+template <typename T, bool Vector = false>
+class spiral_iterator {
+public:
+  using value_type = basic_hex<T, Vector>;
+  using difference_type = std::ptrdiff_t;
+  using iterator_concept = std::random_access_iterator_tag;
+  using iterator_category = std::input_iterator_tag;
+
+  constexpr spiral_iterator() = default;
+  constexpr spiral_iterator(value_type const& center, disk_index index): m_center{ center } { jump(index); }
+
+  constexpr value_type operator*() const { return m_center + m_offset; }
+  constexpr value_type operator[](difference_type n) const { return *(*this + n); }
+
+  constexpr disk_index index() const { return m_index; }
+
+  constexpr spiral_iterator & operator++() {
+    ++m_index;
+    if (m_ring == 0) {
+      m_ring = 1;
+      m_offset = basic_i<T>;
+      return *this;
+    }
+    m_offset = m_offset + details::segment_steps<T>[m_segment];
+    if (++m_step == m_ring) {
+      m_step = 0;
+      if (++m_segment == 6) {
+        m_segment = 0;
+        ++m_ring;
+        m_offset = m_offset + basic_i<T>;
+      }
+    }
+    return *this;
+  }
+
+  constexpr spiral_iterator & operator--() {
+    --m_index;
+    if (m_segment == 0 && m_step == 0) {
+      if (m_ring == 1) {
+        m_ring = 0;
+        m_offset = zero<T>;
+        return *this;
+      }
+      // end of the previous ring
+      --m_ring;
+      m_offset = m_offset - basic_i<T>;
+      m_segment = 6;
+    }
+    if (m_step == 0) {
+      --m_segment;
+      m_step = m_ring;
+    }
+    --m_step;
+    m_offset = m_offset - details::segment_steps<T>[m_segment];
+    return *this;
+  }
+
+  constexpr spiral_iterator operator++(int) { auto copy = *this; ++*this; return copy; }
+  constexpr spiral_iterator operator--(int) { auto copy = *this; --*this; return copy; }
+
+  constexpr spiral_iterator & operator+=(difference_type n) { jump(m_index + n); return *this; }
+  constexpr spiral_iterator & operator-=(difference_type n) { jump(m_index - n); return *this; }
+
+  friend constexpr spiral_iterator operator+(spiral_iterator it, difference_type n) { return it += n; }
+  friend constexpr spiral_iterator operator+(difference_type n, spiral_iterator it) { return it += n; }
+  friend constexpr spiral_iterator operator-(spiral_iterator it, difference_type n) { return it -= n; }
+  friend constexpr difference_type operator-(spiral_iterator const& a, spiral_iterator const& b) {
+    return static_cast<difference_type>(a.m_index) - static_cast<difference_type>(b.m_index);
+  }
+
+  friend constexpr bool operator==(spiral_iterator const& a, spiral_iterator const& b) { return a.m_index == b.m_index; }
+  friend constexpr auto operator<=>(spiral_iterator const& a, spiral_iterator const& b) { return a.m_index <=> b.m_index; }
+
+private:
+  constexpr void jump(disk_index index) {
+    m_index = index;
+    m_ring = ring_radius_of(index);
+    m_segment = 0;
+    m_step = 0;
+    m_offset = m_ring == 0 ? zero<T> : details::vector_in_ring<T>(m_ring, 0);
+    if (m_ring == 0) return;
+    auto const i = index - disk_size(m_ring - 1);
+    m_segment = i / m_ring;
+    m_step = i % m_ring;
+    m_offset = details::vector_in_ring<T>(m_ring, i);
+  }
+
+  value_type m_center{};
+  basic_vector<T> m_offset{};
+  disk_index m_index = 0;
+  ring_radius m_ring = 0;
+  ring_index m_segment = 0;
+  ring_index m_step = 0;
+};
+
+template <typename T, bool Vector = false>
+class ring_view: public std::ranges::view_interface<ring_view<T, Vector>> {
+public:
+  using iterator = ring_iterator<T, Vector>;
+
+  ring_view() = default;
+  constexpr ring_view(basic_hex<T, Vector> const& center, ring_radius radius): m_center{ center }, m_radius{ radius } {}
+
+  constexpr iterator begin() const { return { m_center, m_radius, 0 }; }
+  constexpr iterator end() const { return { m_center, m_radius, ring_size(m_radius) }; }
+  constexpr ring_index size() const { return ring_size(m_radius); }
+
+private:
+  basic_hex<T, Vector> m_center{};
+  ring_radius m_radius = 0;
+};
+
+template <typename T, bool Vector = false>
+class spiral_view: public std::ranges::view_interface<spiral_view<T, Vector>> {
+public:
+  using iterator = spiral_iterator<T, Vector>;
+
+  spiral_view() = default;
+  constexpr spiral_view(basic_hex<T, Vector> const& center, disk_radius radius): m_center{ center }, m_radius{ radius } {}
+
+  constexpr iterator begin() const { return { m_center, 0 }; }
+  constexpr iterator end() const { return { m_center, disk_size(m_radius) }; }
+  constexpr disk_index size() const { return disk_size(m_radius); }
+
+private:
+  basic_hex<T, Vector> m_center{};
+  disk_radius m_radius = 0;
+};
+
+template <typename T>
+ring_view<T> ring_around(basic_point<T> const& center, ring_radius radius) {
+  return { center, radius };
+}
+
+// cells of the disk around center, in spiral index order
+template <typename T>
+spiral_view<T> spiral_around(basic_point<T> const& center, disk_radius radius) {
+  return { center, radius };
+}
+
+// rows of the disk of given radius around the origin, by increasing r
 template <typename T>
-auto ring_around(basic_point<T> const& center, ring_radius radius) {
-  return details::ring_index_range(radius)
-  | std::views::transform([radius, center](ring_index i){ return center + details::vector_in_ring<T>(radius, i);});
+auto disk_rows(disk_radius radius) {
+  auto const R = static_cast<T>(radius);
+  return std::views::iota(-R, static_cast<T>(R + 1))
+  | std::views::transform([R](T r){ return disk_row(R, r); });
 }
 
 template <typename T, bool Vector = false>
-auto ring(ring_radius radius) {
+ring_view<T, Vector> ring(ring_radius radius) {
   if constexpr (Vector) {
-    return details::ring_index_range(radius)
-    | std::views::transform([radius](ring_index i){ return details::vector_in_ring<T>(radius, i); });
+    return { zero<T>, radius };
   } else {
     return ring_around(origin<T>, radius);
   }
 }
 
+template <typename T, bool Vector = false>
+spiral_view<T, Vector> spiral(disk_radius radius) {
+  if constexpr (Vector) {
+    return { zero<T>, radius };
+  } else {
+    return spiral_around(origin<T>, radius);
+  }
+}
+
+
+// a disk splits in 6 sectors of 60°: sector s holds the segment s of every ring, the center is apart.
+// a disk_sector is the part of one sector between two rings (both included).
+struct disk_sector {
+  int sector;
+  ring_radius first_ring;
+  ring_radius last_ring;
+};
+
+template <typename F>
+void for_each_index(disk_sector const& s, F && f) {
+  for (ring_radius ring = s.first_ring; ring <= s.last_ring; ++ring) {
+    if (ring == 0) continue;
+    disk_index const first = disk_size(ring - 1) + static_cast<disk_index>(s.sector) * ring;
+    for (disk_index i = first; i < first + ring; ++i) f(i);
+  }
+}
+
+// 6 * bands sectors covering the disk but its center, bands being cut at equal areas
+inline std::vector<disk_sector> disk_sectors(disk_radius radius, std::size_t bands = 1) {
+  std::vector<disk_sector> sectors;
+  if (radius == 0) return sectors;
+  bands = std::clamp<std::size_t>(bands, 1, radius);
+
+  // cells of a sector up to ring k: k(k+1)/2, so cut rings grow as sqrt
+  std::vector<ring_radius> cuts{ 0 };
+  for (std::size_t b = 1; b <= bands; ++b) {
+    auto cut = static_cast<ring_radius>(std::lround(radius * std::sqrt(static_cast<double>(b) / bands)));
+    cut = std::clamp<ring_radius>(cut, cuts.back() + 1, radius - (bands - b));
+    cuts.push_back(cut);
+  }
+
+  for (int s = 0; s < 6; ++s) {
+    for (std::size_t b = 0; b < bands; ++b) {
+      sectors.push_back({s, cuts[b] + 1, cuts[b + 1]});
+    }
+  }
+  return sectors;
+}
+
 
 template <typename T, bool Vector = false>
 class basic_disk {
@@ -185,7 +562,7 @@ public:
     }
   }
 
-  index_type index_of(value_type const& v) {
+  index_type index_of(value_type const& v) const {
     if constexpr (Vector) {
       return details::disk_index_of(v);
     } else {
@@ -194,6 +571,7 @@ public:
   }
 
   view_type view() const { return m_view; }
+  auto rows() const { return disk_rows<T>(radius()); }
 
 private:
   view_type m_view;
@@ -229,13 +607,13 @@ public:
 
   constexpr value_type value_at(index_type i) const {
     if constexpr (Vector) {
-      return vector_in_disk<T>(radius(), i);
+      return details::vector_in_disk<T>(radius(), i);
     } else {
-      return origin<T> + vector_in_disk<T>(radius(), i);
+      return origin<T> + details::vector_in_disk<T>(radius(), i);
     }
   }
 
-  constexpr index_type index_of(value_type const& v) {
+  constexpr index_type index_of(value_type const& v) const {
     if constexpr (Vector) {
       return details::disk_index_of(v);
     } else {
@@ -244,6 +622,90 @@ public:
   }
 
   view_type view() const { return make_view(); }
+  auto rows() const { return disk_rows<T>(radius()); }
+};
+
+
+// same cells as basic_disk, indexed in row-major order so that dense storage follows rows
+template <typename T, bool Vector = false>
+class basic_row_disk {
+public:
+  using value_type = basic_hex<T, Vector>;
+  using index_type = disk_index;
+
+  using radius_type = disk_radius;
+  using vector_type = basic_vector<T>;
+
+private:
+  static auto make_view(radius_type radius) {
+    return details::disk_index_range(radius);
+  }
+
+public:
+  using view_type = decltype( make_view(0) );
+
+  basic_row_disk(radius_type radius): m_view{ make_view(radius) }, m_radius(radius) {}
+
+  radius_type radius() const { return m_radius; }
+  index_type size() const { return disk_size(radius()); }
+
+  bool is_valid(index_type index) const {
+    return index < size();
+  }
+
+  value_type value_at(index_type i) const {
+    if constexpr (Vector) {
+      return details::vector_in_rows<T>(radius(), i);
+    } else {
+      return origin<T> + details::vector_in_rows<T>(radius(), i);
+    }
+  }
+
+  index_type index_of(value_type const& v) const {
+    if constexpr (Vector) {
+      return details::row_major_index_of(radius(), v);
+    } else {
+      return details::row_major_index_of(radius(), v - origin<T>);
+    }
+  }
+
+  // first index of row r
+  index_type row_offset(T r) const { return details::disk_row_offset(radius(), r); }
+
+  view_type view() const { return m_view; }
+  auto rows() const { return disk_rows<T>(radius()); }
+
+private:
+  view_type m_view;
+  radius_type m_radius;
+};
+
+
+// index conversions between spiral (basic_disk) and row-major (basic_row_disk) orders
+class disk_index_tables {
+public:
+  explicit disk_index_tables(disk_radius radius): m_radius{ radius } {
+    auto const size = disk_size(radius);
+    m_to_spiral.resize(size);
+    m_to_rows.resize(size);
+    for (disk_index i = 0; i < size; ++i) {
+      auto const spiral = details::disk_index_of(details::vector_in_rows<long long>(radius, i));
+      m_to_spiral[i] = spiral;
+      m_to_rows[spiral] = i;
+    }
+  }
+
+  disk_radius radius() const { return m_radius; }
+
+  // spiral index of each row-major index
+  std::span<disk_index const> row_major_to_spiral() const { return m_to_spiral; }
+  // row-major index of each spiral index
+  std::span<disk_index const> spiral_to_row_major() const { return m_to_rows; }
+
+private:
+  disk_radius m_radius;
+  std::vector<disk_index> m_to_spiral;
+  std::vector<disk_index> m_to_rows;
 };
 
 
@@ -261,6 +723,9 @@ using fixed_disk = basic_fixed_disk<Radius, T, false>;
 template <disk_radius Radius, typename T>
 using offsets_fixed_disk = basic_fixed_disk<Radius, T, true>;
 
+template <typename T>
+using row_disk = basic_row_disk<T, false>;
+
 
 
 namespace integers {
@@ -273,6 +738,7 @@ using basic_fixed_disk = hex::basic_fixed_disk<Radius, base_type, Vector>;
 
 using disk = basic_disk<false>;
 using offsets_disk = basic_disk<true>;
+using row_disk = hex::basic_row_disk<base_type, false>;
 
 template <disk_radius Radius>
 using fixed_disk = basic_fixed_disk<false>;
@@ -0,0 +1,221 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_DISK_SYMMETRY_H
+#define OBSIDIAN_GEOMETRY_HEX_DISK_SYMMETRY_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/rotation.h>
+#include <obsidian/geometry/hex/neighbor.h>
+#include <obsidian/geometry/hex/disk.h>
+#include <obsidian/geometry/core/map.h>
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <vector>
+
+// see https://www.redblobgames.com/grids/hexagons/#rotation
+// and https://www.redblobgames.com/grids/hexagons/#reflection
+
+// whole disk rotations and reflections around the origin, done on disk indices.
+// in spiral order, ring r starts at r*|i> and every 60° is a block of r indices,
+// so a rotation is a cyclic shift inside each ring and a reflection is a reversal.
+
+namespace geometry::hex {
+
+/*
+reflection across one of the 6 symmetry lines of the hexagon through the origin.
+lines are numbered counterclockwise every 30°:
+  line 2a goes through the corner in direction axis a (line 0 is the q axis),
+  line 2n+1 goes through the middle of the edge shared with neighborhood n.
+*/
+struct reflection {
+  constexpr explicit reflection(int l): line{modulo(l, 6)} {}
+  constexpr reflection(axis a): line{2 * (static_cast<int>(a) % 3)} {}
+  constexpr reflection(neighborhood n): line{2 * (static_cast<int>(n) % 3) + 1} {}
+
+  int line;
+};
+
+constexpr bool operator==(reflection a, reflection b) { return a.line == b.line; }
+
+// across line l: mirror across the q axis (swap r and s), then rotate by 2*l*30°
+template <typename T>
+constexpr basic_vector<T> operator*(basic_vector<T> const& v, reflection const& r) {
+  return basic_vector<T>{v.q(), v.s()} * counterclockwise(r.line);
+}
+
+template <typename T>
+constexpr basic_vector<T> operator*(reflection const& r, basic_vector<T> const& v) { return v * r; }
+
+static_assert( basic_vector<int>{2,-1} * reflection{axis::q_pos} == basic_vector<int>{2,-1}, "q axis shall be fixed" );
+static_assert( basic_vector<int>{1,0} * reflection{neighborhood::i} == basic_vector<int>{1,0}, "i shall be fixed" );
+static_assert( basic_vector<int>{0,1} * reflection{neighborhood::i} == basic_vector<int>{1,-1}, "j shall go to k_neg" );
+
+
+// any of the 12 symmetries of the hexagon: optional mirror across the q axis, then rotation
+struct symmetry {
+  constexpr symmetry(integral_rotation r = counterclockwise(0), bool mirrored = false):
+    rotation{ r }, reflected{ mirrored } {}
+
+  integral_rotation rotation;
+  bool reflected;
+};
+
+constexpr bool operator==(symmetry a, symmetry b) {
+  return a.rotation.steps == b.rotation.steps && a.reflected == b.reflected;
+}
+
+template <typename T>
+constexpr basic_vector<T> operator*(basic_vector<T> const& v, symmetry const& s) {
+  return (s.reflected ? v * reflection{axis::q_pos} : v) * s.rotation;
+}
+
+constexpr std::array<symmetry, 12> symmetries {
+  symmetry{0_ccw}, symmetry{1_ccw}, symmetry{2_ccw}, symmetry{3_ccw}, symmetry{4_ccw}, symmetry{5_ccw},
+  symmetry{0_ccw, true}, symmetry{1_ccw, true}, symmetry{2_ccw, true},
+  symmetry{3_ccw, true}, symmetry{4_ccw, true}, symmetry{5_ccw, true},
+};
+
+
+namespace details {
+
+// position inside ring of given radius after the transformation
+constexpr ring_index rotated_in_ring(ring_radius radius, ring_index i, integral_rotation const& r) {
+  if (radius == 0) return 0;
+  return (i + radius * static_cast<ring_index>(r.steps)) % ring_size(radius);
+}
+
+constexpr ring_index reflected_in_ring(ring_radius radius, ring_index i, reflection const& r) {
+  if (radius == 0) return 0;
+  // i -> (line-1)*radius - i  (mod 6*radius)
+  auto const size = ring_size(radius);
+  auto const pivot = static_cast<ring_index>(modulo(r.line - 1, 6)) * radius;
+  return (pivot + size - i) % size;
+}
+
+static_assert( reflected_in_ring(1, 1, reflection{neighborhood::i}) == 5, "algorithmic error");
+static_assert( reflected_in_ring(2, 11, reflection{axis::q_pos}) == 11, "algorithmic error");
+
+} // namespace details
+
+
+inline disk_index rotated_index(disk_index i, integral_rotation const& r) {
+  auto const radius = ring_radius_of(i);
+  if (radius == 0) return 0;
+  auto const offset = disk_size(radius - 1);
+  return offset + details::rotated_in_ring(radius, i - offset, r);
+}
+
+inline disk_index reflected_index(disk_index i, reflection const& r) {
+  auto const radius = ring_radius_of(i);
+  if (radius == 0) return 0;
+  auto const offset = disk_size(radius - 1);
+  return offset + details::reflected_in_ring(radius, i - offset, r);
+}
+
+
+/*
+precomputed index permutations of a disk for the 6 rotations and 6 reflections.
+permutation[i] is the index where the value at index i goes.
+*/
+class disk_permutations {
+public:
+  using permutation_type = std::vector<disk_index>;
+
+  explicit disk_permutations(disk_radius radius): m_radius{ radius } {
+    for (int k = 0; k < 6; ++k) {
+      auto & rotation = m_rotations[k];
+      auto & reflection = m_reflections[k];
+      rotation.reserve(disk_size(radius));
+      reflection.reserve(disk_size(radius));
+
+      for (ring_radius ring = 0; ring <= radius; ++ring) {
+        auto const offset = ring == 0 ? 0 : disk_size(ring - 1);
+        for (ring_index i = 0; i < ring_size(ring); ++i) {
+          rotation.push_back(offset + details::rotated_in_ring(ring, i, counterclockwise(k)));
+          reflection.push_back(offset + details::reflected_in_ring(ring, i, hex::reflection{k}));
+        }
+      }
+    }
+  }
+
+  disk_radius radius() const { return m_radius; }
+
+  std::span<disk_index const> rotation(integral_rotation const& r) const { return m_rotations[r.steps]; }
+  std::span<disk_index const> reflection(hex::reflection const& r) const { return m_reflections[r.line]; }
+
+private:
+  disk_radius m_radius;
+  std::array<permutation_type, 6> m_rotations;
+  std::array<permutation_type, 6> m_reflections;
+};
+
+// out[permutation[i]] = in[i]
+template <typename V>
+void permute(std::span<V const> in, std::span<V> out, std::span<disk_index const> permutation) {
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    out[permutation[i]] = in[i];
+  }
+}
+
+
+// in place transformation of values stored in spiral order for a disk of given radius
+
+template <typename V>
+void rotate(std::span<V> values, disk_radius radius, integral_rotation const& r) {
+  if (r.steps == 0) return;
+  for (ring_radius ring = 1; ring <= radius; ++ring) {
+    auto const first = values.begin() + disk_size(ring - 1);
+    auto const size = ring_size(ring);
+    auto const shift = ring * static_cast<ring_index>(r.steps);
+    // value at i goes to i + shift: the new first element is the old [size - shift]
+    std::rotate(first, first + (size - shift), first + size);
+  }
+}
+
+template <typename V>
+void reflect(std::span<V> values, disk_radius radius, reflection const& r) {
+  for (ring_radius ring = 1; ring <= radius; ++ring) {
+    auto const first = values.begin() + disk_size(ring - 1);
+    auto const size = ring_size(ring);
+    // i -> size-1-i, then shift by pivot+1 to get i -> pivot - i
+    auto const shift = (details::reflected_in_ring(ring, 0, r) + 1) % size;
+    std::reverse(first, first + size);
+    std::rotate(first, first + (size - shift) % size, first + size);
+  }
+}
+
+
+// whole map transformations, around the disk center
+
+template <typename Disk, typename Value, typename Allocator>
+void rotate(core::indexed_dense_map<Disk, Value, Allocator> & map, integral_rotation const& r) {
+  rotate(map.values(), map.bounds().radius(), r);
+}
+
+template <typename Disk, typename Value, typename Allocator>
+void reflect(core::indexed_dense_map<Disk, Value, Allocator> & map, reflection const& r) {
+  reflect(map.values(), map.bounds().radius(), r);
+}
+
+// sparse maps are rebuilt from permuted indices, positions are never decoded
+template <typename Disk, typename Value, typename Allocator>
+void rotate(core::indexed_sparse_map<Disk, Value, Allocator> & map, integral_rotation const& r) {
+  core::indexed_sparse_map<Disk, Value, Allocator> result{ map.bounds(), map.get_allocator() };
+  for (auto const& [i, value] : map.mappings()) {
+    result.set(rotated_index(i, r), value);
+  }
+  map = std::move(result);
+}
+
+template <typename Disk, typename Value, typename Allocator>
+void reflect(core::indexed_sparse_map<Disk, Value, Allocator> & map, reflection const& r) {
+  core::indexed_sparse_map<Disk, Value, Allocator> result{ map.bounds(), map.get_allocator() };
+  for (auto const& [i, value] : map.mappings()) {
+    result.set(reflected_index(i, r), value);
+  }
+  map = std::move(result);
+}
+
+} // namespace geometry::hex
+
+#endif
@@ -0,0 +1,217 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_DISTANCE_TRANSFORM_H
+#define OBSIDIAN_GEOMETRY_HEX_DISTANCE_TRANSFORM_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/neighbor.h>
+#include <obsidian/geometry/core/surface.h>
+#include <obsidian/geometry/core/parallel.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+// multi-source distance transform over indexed surfaces:
+// the distance from every cell to its nearest seed, walking through the six neighbors.
+// on a surface without obstacles, this is the hex distance to the nearest seed.
+
+namespace geometry::hex {
+
+template <typename Index, typename Distance = std::uint32_t>
+struct distance_field {
+  using index_type = Index;
+  using distance_type = Distance;
+
+  static constexpr distance_type unreachable = std::numeric_limits<distance_type>::max();
+  static constexpr index_type no_seed = std::numeric_limits<index_type>::max();
+
+  std::vector<distance_type> distance; // per index, unreachable if no seed reaches it
+  std::vector<index_type> nearest; // per index, the nearest seed (smallest index on ties) or no_seed
+};
+
+namespace details {
+
+struct always_passable {
+  template <typename Index>
+  constexpr bool operator()(Index) const { return true; }
+};
+
+template <typename Bounds>
+auto neighbor_steps() {
+  using coordinate_type = typename core::surface_traits<Bounds>::value_type::value_type;
+  std::array<basic_vector<coordinate_type>, 6> steps;
+  for (auto const n : neighborhoods) steps[static_cast<int>(n)] = neighbor_vector<coordinate_type>(n);
+  return steps;
+}
+
+template <typename Field>
+Field make_field(std::size_t size) {
+  Field field;
+  field.distance.assign(size, Field::unreachable);
+  field.nearest.assign(size, Field::no_seed);
+  return field;
+}
+
+} // namespace details
+
+
+/*
+breadth first search from all seeds at once, cells where passable(index) is false are never entered.
+
+the search goes frontier by frontier. with several threads, large frontiers are
+split in chunks, cells being claimed with atomic operations. the result does not
+depend on the number of threads.
+*/
+template <typename Bounds, typename Passable = details::always_passable>
+auto distance_transform(
+  Bounds const& bounds,
+  std::span<typename core::indexed_surface_traits<Bounds>::index_type const> seeds,
+  Passable passable = {},
+  unsigned threads = 1
+) {
+  using traits = core::indexed_surface_traits<Bounds>;
+  using index_type = typename traits::index_type;
+  using field_type = distance_field<index_type>;
+  using distance_type = typename field_type::distance_type;
+
+  constexpr std::size_t minimal_chunk = 4096;
+
+  auto const steps = details::neighbor_steps<Bounds>();
+  auto field = details::make_field<field_type>(traits::size(bounds));
+
+  std::vector<index_type> frontier;
+  for (auto const s : seeds) {
+    if (!traits::is_valid(bounds, s)) continue;
+    if (field.distance[s] != 0) frontier.push_back(s);
+    field.distance[s] = 0;
+    field.nearest[s] = std::min(field.nearest[s], s);
+  }
+
+  std::vector<index_type> next;
+  for (distance_type d = 0; !frontier.empty(); ++d) {
+    std::size_t const chunks = threads <= 1 ? 1 : std::clamp<std::size_t>(frontier.size() / minimal_chunk, 1, 4 * threads);
+
+    if (chunks == 1) {
+      next.clear();
+      for (auto const i : frontier) {
+        auto const p = traits::value_at(bounds, i);
+        auto const seed = field.nearest[i];
+        for (auto const& step : steps) {
+          auto const j = traits::index_of(bounds, p + step);
+          if (!traits::is_valid(bounds, j) || field.distance[j] < d + 1 || !passable(j)) continue;
+          if (field.distance[j] == field_type::unreachable) {
+            field.distance[j] = d + 1;
+            next.push_back(j);
+          }
+          field.nearest[j] = std::min(field.nearest[j], seed);
+        }
+      }
+    } else {
+      std::vector<std::vector<index_type>> claimed(chunks);
+      core::parallel_for(chunks, threads, [&](std::size_t c) {
+        auto const first = frontier.size() * c / chunks;
+        auto const last = frontier.size() * (c + 1) / chunks;
+        for (auto k = first; k < last; ++k) {
+          auto const i = frontier[k];
+          auto const p = traits::value_at(bounds, i);
+          auto const seed = field.nearest[i];
+          for (auto const& step : steps) {
+            auto const j = traits::index_of(bounds, p + step);
+            if (!traits::is_valid(bounds, j) || !passable(j)) continue;
+
+            std::atomic_ref<distance_type> distance{ field.distance[j] };
+            auto expected = field_type::unreachable;
+            if (distance.compare_exchange_strong(expected, d + 1, std::memory_order_relaxed)) {
+              claimed[c].push_back(j);
+            } else if (expected != d + 1) {
+              continue;
+            }
+
+            std::atomic_ref<index_type> nearest{ field.nearest[j] };
+            auto current = nearest.load(std::memory_order_relaxed);
+            while (seed < current && !nearest.compare_exchange_weak(current, seed, std::memory_order_relaxed)) {}
+          }
+        }
+      });
+      next.clear();
+      for (auto const& c : claimed) next.insert(next.end(), c.begin(), c.end());
+    }
+
+    std::swap(frontier, next);
+  }
+
+  return field;
+}
+
+
+/*
+weighted variant: entering cell i costs cost(i), from 1 to max_cost.
+a cost of distance_field::unreachable marks an obstacle.
+
+this is Dial's algorithm: a circular bucket queue of max_cost + 1 buckets
+replaces the priority queue of Dijkstra's algorithm.
+*/
+template <typename Bounds, typename Cost>
+auto weighted_distance_transform(
+  Bounds const& bounds,
+  std::span<typename core::indexed_surface_traits<Bounds>::index_type const> seeds,
+  Cost cost,
+  std::uint32_t max_cost
+) {
+  using traits = core::indexed_surface_traits<Bounds>;
+  using index_type = typename traits::index_type;
+  using field_type = distance_field<index_type>;
+  using distance_type = typename field_type::distance_type;
+
+  auto const steps = details::neighbor_steps<Bounds>();
+  auto field = details::make_field<field_type>(traits::size(bounds));
+
+  std::vector<std::vector<index_type>> buckets(max_cost + 1);
+  std::size_t pending = 0;
+
+  for (auto const s : seeds) {
+    if (!traits::is_valid(bounds, s)) continue;
+    field.distance[s] = 0;
+    field.nearest[s] = std::min(field.nearest[s], s);
+    buckets[0].push_back(s);
+    ++pending;
+  }
+
+  for (distance_type d = 0; pending > 0; ++d) {
+    auto & bucket = buckets[d % buckets.size()];
+    // expanding only pushes in later buckets since costs are at least 1
+    for (std::size_t k = 0; k < bucket.size(); ++k) {
+      auto const i = bucket[k];
+      --pending;
+      if (field.distance[i] != d) continue; // stale entry
+
+      auto const p = traits::value_at(bounds, i);
+      for (auto const& step : steps) {
+        auto const j = traits::index_of(bounds, p + step);
+        if (!traits::is_valid(bounds, j)) continue;
+        auto const c = static_cast<distance_type>(cost(j));
+        if (c == field_type::unreachable) continue;
+
+        auto const reached = d + std::clamp<distance_type>(c, 1, max_cost);
+        if (reached < field.distance[j]) {
+          field.distance[j] = reached;
+          field.nearest[j] = field.nearest[i];
+          buckets[reached % buckets.size()].push_back(j);
+          ++pending;
+        } else if (reached == field.distance[j]) {
+          field.nearest[j] = std::min(field.nearest[j], field.nearest[i]);
+        }
+      }
+    }
+    bucket.clear();
+  }
+
+  return field;
+}
+
+} // namespace geometry::hex
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_FIXED_POINT_H
+#define OBSIDIAN_GEOMETRY_HEX_FIXED_POINT_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/xy.h>
+#include <obsidian/geometry/core/fixed_point.h>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+// see https://www.redblobgames.com/grids/hexagons/#rounding
+
+// fractional hex coordinates in fixed point: from_xy, to_xy and round without any floating point,
+// so that every machine of a lockstep simulation computes the same cells.
+// batch kernels are plain loops over columns (see soa.h): with Q16.16, integer cells to xy and
+// round only use 32 bits adds, multiplies, shifts and blends, 8 lanes per AVX2 instruction.
+
+namespace geometry::hex {
+
+template <typename Fixed>
+struct basic_fixed_xy { Fixed x, y; };
+
+template <typename Fixed>
+constexpr bool operator==(basic_fixed_xy<Fixed> const& a, basic_fixed_xy<Fixed> const& b) {
+  return a.x == b.x && a.y == b.y;
+}
+
+namespace details {
+
+// Orientation coefficients, rounded once to the nearest fixed value at compile time
+template <typename Fixed, bool FlatTop>
+struct fixed_orientation {
+  using orientation = Orientation<FlatTop>;
+
+  static constexpr Fixed q2x = Fixed::from_double(orientation::q2x);
+  static constexpr Fixed q2y = Fixed::from_double(orientation::q2y);
+  static constexpr Fixed r2x = Fixed::from_double(orientation::r2x);
+  static constexpr Fixed r2y = Fixed::from_double(orientation::r2y);
+
+  static constexpr Fixed x2q = Fixed::from_double(orientation::x2q);
+  static constexpr Fixed x2r = Fixed::from_double(orientation::x2r);
+  static constexpr Fixed y2q = Fixed::from_double(orientation::y2q);
+  static constexpr Fixed y2r = Fixed::from_double(orientation::y2r);
+};
+
+// cube rounding on raw values: round every component, then recompute the one which moved most.
+// ties round toward +infinity, where std::round rounds away from zero
+template <int FractionBits, typename Rep, typename I>
+constexpr void round_raw(Rep q, Rep r, I & out_q, I & out_r) {
+  constexpr Rep half = Rep{ 1 } << (FractionBits - 1);
+  Rep const s = -q - r;
+
+  Rep const iq = (q + half) >> FractionBits;
+  Rep const ir = (r + half) >> FractionBits;
+  Rep const is = (s + half) >> FractionBits;
+
+  Rep const dq = absolute(q - (iq << FractionBits));
+  Rep const dr = absolute(r - (ir << FractionBits));
+  Rep const ds = absolute(s - (is << FractionBits));
+
+  bool const fix_q = dq > dr && dq > ds;
+  bool const fix_r = !fix_q && dr > ds;
+  out_q = static_cast<I>(fix_q ? -ir - is : iq);
+  out_r = static_cast<I>(fix_r ? -is - iq : ir);
+}
+
+} // namespace details
+
+
+// center of an integer or fixed point cell, in fixed xy space. exact for integer cells
+template <typename Fixed, bool FlatTop, typename T>
+requires (std::integral<T> || std::same_as<T, Fixed>)
+constexpr basic_fixed_xy<Fixed> to_fixed_xy(Orientation<FlatTop>, basic_point<T> const& p) {
+  using c = details::fixed_orientation<Fixed, FlatTop>;
+  if constexpr (std::integral<T>) {
+    using rep = typename Fixed::rep;
+    auto const q = static_cast<rep>(p.q());
+    auto const r = static_cast<rep>(p.r());
+    return {
+      Fixed::from_raw(q * c::q2x.raw() + r * c::r2x.raw()),
+      Fixed::from_raw(q * c::q2y.raw() + r * c::r2y.raw())
+    };
+  } else {
+    return {
+      p.q() * c::q2x + p.r() * c::r2x,
+      p.q() * c::q2y + p.r() * c::r2y
+    };
+  }
+}
+
+template <typename Fixed, bool FlatTop>
+constexpr basic_point<Fixed> from_fixed_xy(Orientation<FlatTop>, basic_fixed_xy<Fixed> const& p) {
+  using c = details::fixed_orientation<Fixed, FlatTop>;
+  return {
+    p.x * c::x2q + p.y * c::y2q,
+    p.x * c::x2r + p.y * c::y2r
+  };
+}
+
+// nearest cell, see round.h
+template <typename I = integers::base_type, typename Rep, int FractionBits>
+requires std::is_integral_v<I>
+constexpr basic_point<I> round(basic_point<core::basic_fixed<Rep, FractionBits>> const& p) {
+  I q{}, r{};
+  details::round_raw<FractionBits>(p.q().raw(), p.r().raw(), q, r);
+  return { q, r };
+}
+
+static_assert( round(basic_point<core::q16_16>{ core::q16_16::from_double(.6), core::q16_16::from_double(.3) }) == basic_point<int>{1, 0}, "algorithmic error");
+static_assert( round(basic_point<core::q32_32>{ core::q32_32::from_double(-.4), core::q32_32::from_double(-.4) }) == basic_point<int>{0, -1}, "algorithmic error");
+static_assert( round(from_fixed_xy(FlatTop{}, to_fixed_xy<core::q16_16>(FlatTop{}, basic_point<int>{-7, 3}))) == basic_point<int>{-7, 3}, "algorithmic error");
+static_assert( round(from_fixed_xy(PointyTop{}, to_fixed_xy<core::q32_32>(PointyTop{}, basic_point<int>{5, -9}))) == basic_point<int>{5, -9}, "algorithmic error");
+
+
+// batch kernels: every span of a call shall hold the same count of elements
+
+// x[i], y[i] = to_fixed_xy(basic_point{q[i], r[i]})
+template <typename Fixed, bool FlatTop, std::integral I>
+void to_fixed_xy(
+  Orientation<FlatTop>,
+  std::span<I const> q_column,
+  std::span<I const> r_column,
+  std::span<Fixed> x_column,
+  std::span<Fixed> y_column
+) {
+  using c = details::fixed_orientation<Fixed, FlatTop>;
+  using rep = typename Fixed::rep;
+  constexpr rep q2x = c::q2x.raw(), q2y = c::q2y.raw(), r2x = c::r2x.raw(), r2y = c::r2y.raw();
+
+  I const * __restrict q = q_column.data();
+  I const * __restrict r = r_column.data();
+  Fixed * __restrict x = x_column.data();
+  Fixed * __restrict y = y_column.data();
+  std::size_t const n = q_column.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    auto const qi = static_cast<rep>(q[i]);
+    auto const ri = static_cast<rep>(r[i]);
+    x[i] = Fixed::from_raw(qi * q2x + ri * r2x);
+    y[i] = Fixed::from_raw(qi * q2y + ri * r2y);
+  }
+}
+
+// q[i], r[i] = from_fixed_xy(xy{x[i], y[i]})
+template <typename Fixed, bool FlatTop>
+void from_fixed_xy(
+  Orientation<FlatTop> orientation,
+  std::span<Fixed const> x_column,
+  std::span<Fixed const> y_column,
+  std::span<Fixed> q_column,
+  std::span<Fixed> r_column
+) {
+  Fixed const * __restrict x = x_column.data();
+  Fixed const * __restrict y = y_column.data();
+  Fixed * __restrict q = q_column.data();
+  Fixed * __restrict r = r_column.data();
+  std::size_t const n = x_column.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    auto const p = from_fixed_xy(orientation, basic_fixed_xy<Fixed>{ x[i], y[i] });
+    q[i] = p.q();
+    r[i] = p.r();
+  }
+}
+
+// out_q[i], out_r[i] = round(basic_point{q[i], r[i]})
+template <typename Rep, int FractionBits, std::integral I>
+void round(
+  std::span<core::basic_fixed<Rep, FractionBits> const> q_column,
+  std::span<core::basic_fixed<Rep, FractionBits> const> r_column,
+  std::span<I> out_q_column,
+  std::span<I> out_r_column
+) {
+  using fixed = core::basic_fixed<Rep, FractionBits>;
+  fixed const * __restrict q = q_column.data();
+  fixed const * __restrict r = r_column.data();
+  I * __restrict out_q = out_q_column.data();
+  I * __restrict out_r = out_r_column.data();
+  std::size_t const n = q_column.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    details::round_raw<FractionBits>(q[i].raw(), r[i].raw(), out_q[i], out_r[i]);
+  }
+}
+
+
+namespace fixed16 {
+using base_type = core::q16_16;
+
+using point = basic_point<base_type>;
+using vector = basic_vector<base_type>;
+using xy = basic_fixed_xy<base_type>;
+}
+
+namespace fixed32 {
+using base_type = core::q32_32;
+
+using point = basic_point<base_type>;
+using vector = basic_vector<base_type>;
+using xy = basic_fixed_xy<base_type>;
+}
+
+} // namespace geometry::hex
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <obsidian/geometry/hex/coordinates.h>
 
+#include <functional>
 #include <utility>
 
 // see https://www.redblobgames.com/grids/hexagons/
@@ -0,0 +1,230 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_HIERARCHY_H
+#define OBSIDIAN_GEOMETRY_HEX_HIERARCHY_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/neighbor.h>
+#include <obsidian/geometry/hex/disk.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// see https://www.redblobgames.com/grids/hexagons/ and the gosper island
+
+/*
+aperture 7 hierarchy: a cell of level k+1 covers 7 cells of level k, its center child and the
+6 neighbors of that child, as a disk of radius 1 (disk_size(1) == 7).
+center children form the sublattice spanned by <2,1> and <-1,3> (both of norm 7, 60° apart):
+cell <m,n> of level k+1 has its center child at m*<2,1> + n*<-1,3> = <2m-n, m+3n> of level k.
+each level is an axial system of its own, rotated by atan(sqrt(3)/5) ~ 19.1° and scaled by sqrt(7).
+
+the other way, <q,r> = m*<2,1> + n*<-1,3> gives m = (3q+r)/7 and n = (2r-q)/7.
+a neighbor offset adds at most 3/7 to m and n, so the parent is found by rounding both.
+*/
+
+namespace geometry::hex {
+
+// digit of a child in its parent: 0 for the center child, 1 + k for the one in neighborhood k
+using child_digit_type = int;
+
+namespace details {
+
+// nearest integer of a/7, a/7 never being a half
+template <typename T>
+constexpr T round_div7(T a) {
+  a += 3;
+  return (a >= 0 ? a : a - 6) / 7;
+}
+
+} // namespace details
+
+template <typename T>
+constexpr basic_point<T> parent(basic_point<T> const& p) {
+  return {
+    details::round_div7<T>(3 * p.q() + p.r()),
+    details::round_div7<T>(2 * p.r() - p.q())
+  };
+}
+
+template <typename T>
+constexpr basic_point<T> center_child(basic_point<T> const& p) {
+  return { 2 * p.q() - p.r(), p.q() + 3 * p.r() };
+}
+
+template <typename T>
+constexpr basic_point<T> child(basic_point<T> const& p, child_digit_type digit) {
+  auto const center = center_child(p);
+  return digit == 0 ? center : center + neighbor_vector<T>(neighborhood::i + (digit - 1));
+}
+
+// children in digit order
+template <typename T>
+constexpr std::array<basic_point<T>, 7> children(basic_point<T> const& p) {
+  auto const center = center_child(p);
+  return {
+    center,
+    center + neighbor_vector<T>(neighborhood::i),
+    center + neighbor_vector<T>(neighborhood::j),
+    center + neighbor_vector<T>(neighborhood::k),
+    center + neighbor_vector<T>(neighborhood::i_neg),
+    center + neighbor_vector<T>(neighborhood::j_neg),
+    center + neighbor_vector<T>(neighborhood::k_neg),
+  };
+}
+
+template <typename T>
+constexpr child_digit_type child_digit(basic_point<T> const& p) {
+  return static_cast<child_digit_type>(details::disk_index_of(p - center_child(parent(p))));
+}
+
+/*
+cell holding p, levels above it. O(levels): every level rounds, and rounding k times is not
+one rounded division by (2+w)^k (the cells below a coarse cell form a gosper island, not the
+cells nearest to its center), so there is no closed form. levels stay small, 7^levels cells being covered.
+*/
+template <typename T>
+constexpr basic_point<T> ancestor(basic_point<T> p, std::size_t levels) {
+  for (; levels > 0; --levels) p = parent(p);
+  return p;
+}
+
+/*
+center cell of p, levels below it.
+center_child is linear, the images of the units being <2,1> and <-1,3>:
+its power is found by squaring, O(log levels).
+*/
+template <typename T>
+constexpr basic_point<T> center_descendant(basic_point<T> const& p, std::size_t levels) {
+  // image of w by the linear map sending the units to u and v
+  auto const apply = [](basic_vector<T> const& u, basic_vector<T> const& v, basic_vector<T> const& w) {
+    return w.q() * u + w.r() * v;
+  };
+  basic_vector<T> result_u{1, 0}, result_v{0, 1};
+  basic_vector<T> square_u{2, 1}, square_v{-1, 3};
+  while (levels > 0) {
+    if (levels & 1) {
+      result_u = apply(square_u, square_v, result_u);
+      result_v = apply(square_u, square_v, result_v);
+    }
+    levels >>= 1;
+    if (levels == 0) break;
+    auto const u = apply(square_u, square_v, square_u);
+    square_v = apply(square_u, square_v, square_v);
+    square_u = u;
+  }
+  return origin<T> + apply(result_u, result_v, p - origin<T>);
+}
+
+static_assert( parent(basic_point<int>{2, 1}) == basic_point<int>{1, 0}, "algorithmic error");
+static_assert( parent(basic_point<int>{3, 1}) == basic_point<int>{1, 0}, "algorithmic error");
+static_assert( parent(basic_point<int>{-3, 2}) == basic_point<int>{-1, 1}, "algorithmic error");
+static_assert( parent(child(basic_point<int>{-4, 7}, 5)) == basic_point<int>{-4, 7}, "algorithmic error");
+static_assert( child_digit(child(basic_point<int>{3, -2}, 4)) == 4, "algorithmic error");
+static_assert( center_descendant(basic_point<int>{-2, 3}, 5) == center_child(center_child(center_child(center_child(center_child(basic_point<int>{-2, 3}))))), "algorithmic error");
+static_assert( ancestor(center_descendant(basic_point<int>{4, -1}, 6), 6) == basic_point<int>{4, -1}, "algorithmic error");
+
+
+// reductions over the base cells covered by a cell of some level
+template <typename Value>
+struct aggregate {
+  Value sum{};
+  Value min{};
+  Value max{};
+  std::size_t count = 0;
+};
+
+/*
+values of a disk around the origin, with their reductions at every level of the hierarchy.
+setting a base value recomputes its ancestors from their 7 children: O(7 * levels).
+level k is stored densely on the smallest disk holding the ancestors of the base disk.
+*/
+template <typename T, typename Value>
+class aggregation_pyramid {
+public:
+  using point_type = basic_point<T>;
+  using aggregate_type = aggregate<Value>;
+
+  aggregation_pyramid(disk_radius radius, std::size_t levels, Value const& fill = Value{}) {
+    m_bounds.emplace_back(radius);
+    m_base.assign(disk_size(radius), fill);
+
+    for (std::size_t level = 1; level <= levels && m_bounds.back().radius() > 0; ++level) {
+      auto const below = m_bounds.back();
+
+      disk_radius upper = 0;
+      for (auto const i : below.view()) {
+        upper = std::max(upper, static_cast<disk_radius>(length(parent(below.value_at(i)) - origin<T>)));
+      }
+      m_bounds.emplace_back(upper);
+      m_levels.emplace_back(disk_size(upper));
+
+      auto const bounds = m_bounds.back();
+      auto & cells = m_levels.back();
+      for (auto const i : below.view()) {
+        auto & cell = cells[bounds.index_of(parent(below.value_at(i)))];
+        merge(cell, child_aggregate(level - 1, i));
+      }
+    }
+  }
+
+  // levels above the base
+  std::size_t levels() const { return m_levels.size(); }
+
+  basic_disk<T> const& bounds(std::size_t level) const { return m_bounds[level]; }
+
+  Value const& get(point_type const& p) const { return m_base[m_bounds[0].index_of(p)]; }
+
+  // p shall be in the base disk
+  void set(point_type const& p, Value const& v) {
+    m_base[m_bounds[0].index_of(p)] = v;
+
+    auto cell = p;
+    for (std::size_t level = 1; level <= levels(); ++level) {
+      cell = parent(cell);
+      auto & target = m_levels[level - 1][m_bounds[level].index_of(cell)];
+      target = aggregate_type{};
+      for (auto const& c : children(cell)) {
+        auto const i = m_bounds[level - 1].index_of(c);
+        if (m_bounds[level - 1].is_valid(i)) merge(target, child_aggregate(level - 1, i));
+      }
+    }
+  }
+
+  // reductions of a cell of level >= 1, count being 0 out of the map
+  aggregate_type at(std::size_t level, point_type const& cell) const {
+    auto const i = m_bounds[level].index_of(cell);
+    return m_bounds[level].is_valid(i) ? m_levels[level - 1][i] : aggregate_type{};
+  }
+
+  // all cells of a level >= 1, by index of bounds(level)
+  std::span<aggregate_type const> level(std::size_t level) const { return m_levels[level - 1]; }
+  std::span<Value const> base() const { return m_base; }
+
+private:
+  aggregate_type child_aggregate(std::size_t level, disk_index i) const {
+    if (level > 0) return m_levels[level - 1][i];
+    return { m_base[i], m_base[i], m_base[i], 1 };
+  }
+
+  static void merge(aggregate_type & a, aggregate_type const& b) {
+    if (b.count == 0) return;
+    if (a.count == 0) {
+      a = b;
+      return;
+    }
+    a.sum += b.sum;
+    a.min = std::min(a.min, b.min);
+    a.max = std::max(a.max, b.max);
+    a.count += b.count;
+  }
+
+  std::vector<basic_disk<T>> m_bounds;
+  std::vector<Value> m_base;
+  std::vector<std::vector<aggregate_type>> m_levels;
+};
+
+} // namespace geometry::hex
+
+#endif
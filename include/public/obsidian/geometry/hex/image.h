@@ -0,0 +1,169 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_IMAGE_H
+#define OBSIDIAN_GEOMETRY_HEX_IMAGE_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/round.h>
+#include <obsidian/geometry/hex/xy.h>
+#include <obsidian/geometry/core/parallel.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+
+// see https://www.redblobgames.com/grids/hexagons/#pixel-to-hex
+
+// software rendering of hex maps into RGBA images, without any graphics library.
+// pixel centers are brought back to fractional q/r and rounded to their cell.
+// from_xy being linear, q and r only grow by a constant step along a scanline:
+// the pixels of a cell are then found at once from where the scanline leaves it.
+
+namespace geometry::hex {
+
+// r, g, b, a
+using image_color = std::array<std::uint8_t, 4>;
+
+// bytes of an RGBA image, rows from the top
+constexpr std::size_t image_bytes(std::size_t width, std::size_t height) { return 4 * width * height; }
+
+struct image_options {
+  image_color outline{ 0, 0, 0, 255 };
+  double outline_width = 0; // in pixels, no outline when 0
+  unsigned threads = 1;
+};
+
+namespace details {
+
+/*
+max(|dq-dr|, |dr-ds|, |ds-dq|) for the offset to the cell center:
+0 at the center, 1 on the edges, growing linearly in between.
+*/
+constexpr double edge_ratio(double dq, double dr) {
+  double const ds = -dq - dr;
+  return std::max({ absolute(dq - dr), absolute(dr - ds), absolute(ds - dq) });
+}
+
+static_assert( edge_ratio(0, 0) == 0, "algorithmic error");
+static_assert( edge_ratio(.5, 0) == 1, "algorithmic error");
+static_assert( edge_ratio(2/3., -1/3.) == 1, "algorithmic error");
+
+/*
+along the line offset(x) = offset + x * step, the interval of x where edge_ratio <= bound.
+each of the three terms is linear in x, so the interval is the intersection of three slabs.
+*/
+inline std::array<double, 2> ratio_interval(
+  basic_point<double> const& offset,
+  basic_point<double> const& step,
+  double bound
+) {
+  std::array<double, 2> result{ -HUGE_VAL, HUGE_VAL };
+  auto const slab = [&](double a, double b) {
+    if (b == 0) {
+      if (absolute(a) > bound) result = { HUGE_VAL, -HUGE_VAL };
+      return;
+    }
+    auto const x0 = (-bound - a) / b;
+    auto const x1 = (bound - a) / b;
+    result[0] = std::max(result[0], std::min(x0, x1));
+    result[1] = std::min(result[1], std::max(x0, x1));
+  };
+  slab(offset.q() - offset.r(), step.q() - step.r());
+  slab(offset.q() + 2 * offset.r(), step.q() + 2 * step.r());
+  slab(-2 * offset.q() - offset.r(), -2 * step.q() - step.r());
+  return result;
+}
+
+} // namespace details
+
+
+/*
+draws the map into rgba, of image_bytes(width, height) bytes.
+pixel (x, y) covers the screen square [x, x+1) × [y, y+1), its color being the one of the cell
+holding its center: fill(cell) shall return an image_color (cells outside the map included).
+rows are split into bands drawn by options.threads threads.
+*/
+template <typename T = integers::base_type, typename Point2D, bool FlatTop, typename Fill>
+void render_image(
+  std::span<std::uint8_t> rgba,
+  std::size_t width,
+  std::size_t height,
+  screen::ScreenTransformation<Point2D> const& screen,
+  Orientation<FlatTop>,
+  Fill && fill,
+  image_options const& options = {}
+) {
+  using orientation = Orientation<FlatTop>;
+
+  if (rgba.size() < image_bytes(width, height)) return;
+
+  // screen to q/r: step of one pixel along a scanline
+  basic_point<double> const step{ orientation::x2q / screen.scale.x, orientation::x2r / screen.scale.x };
+
+  // an edge is at inner radius K from the center: a pixel is on the outline when
+  // its distance to the edge, (1 - edge_ratio) * K, is below half the outline width
+  double const pixel_size = 1 / std::min(details::absolute(screen.scale.x), details::absolute(screen.scale.y));
+  double const outline_ratio = 1 - options.outline_width * pixel_size / 2 / orientation::K;
+  bool const outlined = options.outline_width > 0;
+
+  constexpr std::size_t band = 16;
+  std::size_t const bands = (height + band - 1) / band;
+
+  core::parallel_for(bands, options.threads, [&](std::size_t b) {
+    auto const last_row = std::min(height, (b + 1) * band);
+    for (std::size_t y = b * band; y < last_row; ++y) {
+      auto const start = orientation::from_xy(screen.from_screen(.5, y + .5));
+      std::uint8_t * const row = rgba.data() + image_bytes(width, y);
+
+      // one cell at a time: its pixels are found from where the scanline leaves it
+      for (std::size_t x = 0; x < width; ) {
+        auto const cell = round<T>(basic_point<double>{ start.q() + x * step.q(), start.r() + x * step.r() });
+        auto const color = fill(cell);
+        basic_point<double> const offset{ start.q() - cell.q(), start.r() - cell.r() };
+
+        auto const [enter, leave] = details::ratio_interval(offset, step, 1);
+        auto const end = std::clamp(static_cast<std::size_t>(std::max(0., std::floor(leave) + 1)), x + 1, width);
+
+        std::size_t inner_begin = x, inner_end = end;
+        if (outlined) {
+          auto const [low, high] = details::ratio_interval(offset, step, outline_ratio);
+          inner_begin = std::clamp(static_cast<std::size_t>(std::max(0., std::ceil(low))), x, end);
+          inner_end = std::clamp(static_cast<std::size_t>(std::max(0., std::floor(high) + 1)), inner_begin, end);
+        }
+
+        auto const paint = [row](std::size_t first, std::size_t last, image_color const& c) {
+          for (auto * out = row + 4 * first; out != row + 4 * last; out += 4) std::copy(c.begin(), c.end(), out);
+        };
+        paint(x, inner_begin, options.outline);
+        paint(inner_begin, inner_end, color);
+        paint(inner_end, end, options.outline);
+        x = end;
+      }
+    }
+  });
+}
+
+/*
+binary PPM (P6) of an RGBA image, alpha being dropped.
+the raw RGBA bytes need no encoding and can be written as they are.
+*/
+inline void write_ppm(std::ostream & os, std::span<std::uint8_t const> rgba, std::size_t width, std::size_t height) {
+  os << "P6\n" << width << ' ' << height << "\n255\n";
+
+  std::array<char, 3 * 1024> line;
+  std::size_t used = 0;
+  for (std::size_t i = 0; i < width * height; ++i) {
+    for (std::size_t c = 0; c < 3; ++c) line[used++] = static_cast<char>(rgba[4 * i + c]);
+    if (used == line.size()) {
+      os.write(line.data(), static_cast<std::streamsize>(used));
+      used = 0;
+    }
+  }
+  os.write(line.data(), static_cast<std::streamsize>(used));
+}
+
+} // namespace geometry::hex
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_MESH_H
+#define OBSIDIAN_GEOMETRY_HEX_MESH_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/xy.h>
+
+#include <array>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+// vertex buffers for many cells at once, to be drawn with a single call.
+// the buffer belongs to the caller: building a mesh never allocates.
+
+namespace geometry::hex {
+
+enum struct mesh_primitive {
+  triangles, // filled cells: 4 triangles fanned from the first corner
+  lines,     // outlines: the 6 edges as separate segments
+};
+
+// a vertex is x, y then r, g, b, a when colored
+constexpr std::size_t mesh_vertex_floats(bool colored) { return colored ? 6 : 2; }
+constexpr std::size_t mesh_cell_vertices(mesh_primitive) { return 12; }
+
+constexpr std::size_t mesh_cell_floats(mesh_primitive primitive, bool colored) {
+  return mesh_cell_vertices(primitive) * mesh_vertex_floats(colored);
+}
+
+// floats needed for a mesh of `cells` cells
+constexpr std::size_t mesh_floats(mesh_primitive primitive, bool colored, std::size_t cells) {
+  return cells * mesh_cell_floats(primitive, colored);
+}
+
+// per cell color, as r, g, b, a
+using mesh_color = std::array<float, 4>;
+
+namespace details {
+
+struct no_mesh_color {};
+
+// corners used by the vertices of a cell
+constexpr std::array<int, 12> fan_corners { 0,1,2, 0,2,3, 0,3,4, 0,4,5 };
+constexpr std::array<int, 12> outline_corners { 0,1, 1,2, 2,3, 3,4, 4,5, 5,0 };
+
+} // namespace details
+
+
+/*
+writes the vertices of every cell, in order, into buffer, positions in xy units scaled by size.
+color, when given, is called once per cell and shall return a mesh_color.
+only whole cells are written: returns the count of floats written.
+*/
+template <
+  bool FlatTop,
+  std::ranges::input_range Cells,
+  typename Color = details::no_mesh_color
+>
+std::size_t build_mesh(
+  std::span<float> buffer,
+  Cells && cells,
+  Orientation<FlatTop> orientation,
+  mesh_primitive primitive,
+  double size = 1,
+  Color color = {}
+) {
+  constexpr bool colored = !std::is_same_v<Color, details::no_mesh_color>;
+  auto const cell_floats = mesh_cell_floats(primitive, colored);
+
+  auto const& order = primitive == mesh_primitive::triangles ? details::fan_corners : details::outline_corners;
+  auto const offsets = orientation.corners(size);
+
+  float * out = buffer.data();
+  float * const end = buffer.data() + buffer.size();
+
+  for (auto const& p : cells) {
+    if (static_cast<std::size_t>(end - out) < cell_floats) break;
+
+    auto const center = orientation.to_xy(p);
+    mesh_color rgba{};
+    if constexpr (colored) rgba = color(p);
+
+    for (auto const corner : order) {
+      *out++ = static_cast<float>(center.x * size + offsets[corner].x);
+      *out++ = static_cast<float>(center.y * size + offsets[corner].y);
+      if constexpr (colored) {
+        for (auto const c : rgba) *out++ = c;
+      }
+    }
+  }
+
+  return static_cast<std::size_t>(out - buffer.data());
+}
+
+} // namespace geometry::hex
+
+#endif
@@ -17,6 +17,7 @@
 #include <obsidian/geometry/hex/rotation.h>
 
 #include <array>
+#include <cstddef>
 
 namespace geometry::hex {
 /*  flat top wheel:
@@ -76,6 +77,16 @@ template <typename T>
 constexpr basic_point<T>& operator|=(basic_point<T>& p, neighborhood n) { return p = neighbor(p, n); }
 
 
+// values of the six neighbors of p in map, in neighborhoods order, nullptr where unmapped.
+// map is any map of core/map.h or hex/ keyed (or indexed) by points, through its optional(point)
+template <typename Map, typename T>
+auto neighbor_values(Map const& map, basic_point<T> const& p) {
+  std::array<decltype(map.optional(p)), 6> result;
+  for (std::size_t n = 0; n < result.size(); ++n) result[n] = map.optional(p + neighbor_vector<T>(neighborhoods[n]));
+  return result;
+}
+
+
 template <typename T, neighborhood N>
 constexpr basic_vector<T> basic_neighbor = neighbor_vector<T>(N);
 
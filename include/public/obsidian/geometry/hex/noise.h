@@ -0,0 +1,168 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_NOISE_H
+#define OBSIDIAN_GEOMETRY_HEX_NOISE_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/xy.h>
+#include <obsidian/geometry/core/surface.h>
+#include <obsidian/geometry/core/parallel.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// procedural noise sampled at cell centers, in xy space.
+// lattice values come from a hash of (seed, octave, lattice point) instead of a random
+// generator state: any cell can be computed alone, in any order, on any thread.
+
+namespace geometry::hex {
+
+enum struct noise_kind {
+  value,    // random values at lattice points, smoothly interpolated
+  gradient, // random gradients at lattice points (Perlin)
+};
+
+struct noise_options {
+  noise_kind kind = noise_kind::gradient;
+  std::uint32_t seed = 0;
+  double frequency = .1;    // lattice points per xy unit for the first octave
+  unsigned octaves = 1;     // fBm: every octave adds the noise at frequency * lacunarity^o
+  double lacunarity = 2;
+  double gain = .5;         // amplitude ratio between octaves
+  unsigned threads = 1;
+};
+
+namespace details {
+
+// 32 bits hash of a lattice point (integer multiplies and shifts only, so that it vectorizes)
+constexpr std::uint32_t lattice_hash(std::uint32_t seed, std::int32_t x, std::int32_t y) {
+  std::uint32_t h = seed
+    ^ (static_cast<std::uint32_t>(x) * 0x8da6b343u)
+    ^ (static_cast<std::uint32_t>(y) * 0xd8163841u);
+  h ^= h >> 16;
+  h *= 0x7feb352du;
+  h ^= h >> 15;
+  h *= 0x846ca68bu;
+  h ^= h >> 16;
+  return h;
+}
+
+// quintic fade, null first and second derivatives at 0 and 1
+constexpr float fade(float t) { return t * t * t * (t * (t * 6 - 15) + 10); }
+constexpr float lerp(float a, float b, float t) { return a + t * (b - a); }
+
+// floor without a call to std::floor, for |x| < 2^31
+constexpr std::int32_t lattice_floor(float x) {
+  auto const i = static_cast<std::int32_t>(x);
+  return i - static_cast<std::int32_t>(x < static_cast<float>(i));
+}
+
+// noise at a point of the lattice space: value noise is in [-1, 1], gradient noise well within it
+template <noise_kind Kind>
+constexpr float lattice_noise(float x, float y, std::uint32_t seed) {
+  auto const ix = lattice_floor(x);
+  auto const iy = lattice_floor(y);
+  auto const fx = x - static_cast<float>(ix);
+  auto const fy = y - static_cast<float>(iy);
+
+  auto const corner = [&](std::int32_t dx, std::int32_t dy) {
+    auto const h = lattice_hash(seed, ix + dx, iy + dy);
+    if constexpr (Kind == noise_kind::value) {
+      return static_cast<float>(h >> 8) * (2.f / 16777216.f) - 1.f;
+    } else {
+      // gradient components in [-1, 1], dotted with the offset to the corner
+      auto const gx = static_cast<float>(h & 0xffffu) * (2.f / 65535.f) - 1.f;
+      auto const gy = static_cast<float>(h >> 16) * (2.f / 65535.f) - 1.f;
+      return gx * (fx - static_cast<float>(dx)) + gy * (fy - static_cast<float>(dy));
+    }
+  };
+
+  auto const u = fade(fx);
+  auto const v = fade(fy);
+  return lerp(lerp(corner(0, 0), corner(1, 0), u), lerp(corner(0, 1), corner(1, 1), u), v);
+}
+
+inline constexpr std::size_t noise_batch = 64;
+
+// fBm over a batch of positions: plain loops over arrays, for the compiler to vectorize
+template <noise_kind Kind>
+void fbm_batch(
+  std::span<float const> x,
+  std::span<float const> y,
+  std::span<float> out,
+  noise_options const& options
+) {
+  std::array<float, noise_batch> sum{};
+  float frequency = static_cast<float>(options.frequency);
+  float amplitude = 1;
+  float total = 0;
+
+  for (unsigned octave = 0; octave < std::max(1u, options.octaves); ++octave) {
+    auto const seed = lattice_hash(options.seed, static_cast<std::int32_t>(octave), 0x5eed);
+    for (std::size_t i = 0; i < out.size(); ++i) {
+      sum[i] += amplitude * lattice_noise<Kind>(x[i] * frequency, y[i] * frequency, seed);
+    }
+    total += amplitude;
+    frequency *= static_cast<float>(options.lacunarity);
+    amplitude *= static_cast<float>(options.gain);
+  }
+
+  for (std::size_t i = 0; i < out.size(); ++i) out[i] = sum[i] / total;
+}
+
+} // namespace details
+
+
+/*
+fills values with the noise at every cell of bounds, values[i] being for index i.
+cells are processed by fixed chunks whatever the count of threads,
+so the result is bit-identical for any options.threads.
+*/
+template <bool FlatTop, typename Bounds>
+void generate_noise(
+  Bounds const& bounds,
+  std::span<float> values,
+  Orientation<FlatTop> orientation,
+  noise_options const& options = {}
+) {
+  using traits = core::indexed_surface_traits<Bounds>;
+  using index_type = typename traits::index_type;
+
+  auto const size = std::min<std::size_t>(traits::size(bounds), values.size());
+  constexpr std::size_t chunk = 64 * details::noise_batch;
+  auto const chunks = (size + chunk - 1) / chunk;
+
+  core::parallel_for(chunks, options.threads, [&](std::size_t c) {
+    std::array<float, details::noise_batch> x, y;
+    auto const last = std::min(size, (c + 1) * chunk);
+    for (std::size_t first = c * chunk; first < last; first += details::noise_batch) {
+      auto const count = std::min(details::noise_batch, last - first);
+      for (std::size_t i = 0; i < count; ++i) {
+        auto const p = orientation.to_xy(traits::value_at(bounds, static_cast<index_type>(first + i)));
+        x[i] = static_cast<float>(p.x);
+        y[i] = static_cast<float>(p.y);
+      }
+
+      std::span<float const> const xs{ x.data(), count }, ys{ y.data(), count };
+      auto const out = values.subspan(first, count);
+      if (options.kind == noise_kind::value) details::fbm_batch<noise_kind::value>(xs, ys, out, options);
+      else details::fbm_batch<noise_kind::gradient>(xs, ys, out, options);
+    }
+  });
+}
+
+// noise at a single cell, equal to what generate_noise gives for it
+template <typename T, bool FlatTop>
+float noise_at(basic_point<T> const& p, Orientation<FlatTop> orientation, noise_options const& options = {}) {
+  auto const xy = orientation.to_xy(p);
+  float const x = static_cast<float>(xy.x), y = static_cast<float>(xy.y);
+  float result = 0;
+  if (options.kind == noise_kind::value) details::fbm_batch<noise_kind::value>({ &x, 1 }, { &y, 1 }, { &result, 1 }, options);
+  else details::fbm_batch<noise_kind::gradient>({ &x, 1 }, { &y, 1 }, { &result, 1 }, options);
+  return result;
+}
+
+} // namespace geometry::hex
+
+#endif
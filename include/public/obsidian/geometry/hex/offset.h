@@ -0,0 +1,206 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_OFFSET_H
+#define OBSIDIAN_GEOMETRY_HEX_OFFSET_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <version>
+
+#if defined(__cpp_lib_mdspan)
+#include <mdspan>
+#endif
+
+// see https://www.redblobgames.com/grids/hexagons/#coordinates-offset
+// and https://www.redblobgames.com/grids/hexagons/#conversions-offset
+
+/*
+offset coordinates: cells of a rectangle as (col, row), the way external rasters store them.
+a row is the line of cells growing in r (rows of "r" layouts) or a column the line growing in q
+("q" layouts, for flat top hexagons), every other one being shoved by half a cell:
+  odd_q:  odd columns are shoved toward increasing rows
+  even_q: even columns are
+  odd_r:  odd rows are shoved toward increasing columns
+  even_r: even rows are
+row 0 holds r == 0 and grows with r: with the y up convention of xy.h, an image with its
+first row on top shows flipped vertically.
+*/
+
+namespace geometry::hex {
+
+enum struct offset_layout {
+  odd_q,
+  even_q,
+  odd_r,
+  even_r,
+};
+
+template <typename T>
+struct basic_offset {
+  T col, row;
+};
+
+template <typename T>
+constexpr bool operator==(basic_offset<T> const& a, basic_offset<T> const& b) {
+  return a.col == b.col && a.row == b.row;
+}
+
+// (x & 1) is the parity of x for negative values too, with two's complement integers
+template <typename T>
+constexpr basic_offset<T> to_offset(offset_layout layout, basic_point<T> const& p) {
+  auto const q = p.q(), r = p.r();
+  switch (layout) {
+    default:
+    case offset_layout::odd_q:  return { q, r + (q - (q & 1)) / 2 };
+    case offset_layout::even_q: return { q, r + (q + (q & 1)) / 2 };
+    case offset_layout::odd_r:  return { q + (r - (r & 1)) / 2, r };
+    case offset_layout::even_r: return { q + (r + (r & 1)) / 2, r };
+  }
+}
+
+template <typename T>
+constexpr basic_point<T> from_offset(offset_layout layout, basic_offset<T> const& o) {
+  auto const col = o.col, row = o.row;
+  switch (layout) {
+    default:
+    case offset_layout::odd_q:  return { col, row - (col - (col & 1)) / 2 };
+    case offset_layout::even_q: return { col, row - (col + (col & 1)) / 2 };
+    case offset_layout::odd_r:  return { col - (row - (row & 1)) / 2, row };
+    case offset_layout::even_r: return { col - (row + (row & 1)) / 2, row };
+  }
+}
+
+static_assert( to_offset(offset_layout::odd_q, basic_point<int>{3, -1}) == basic_offset<int>{3, 0}, "algorithmic error");
+static_assert( to_offset(offset_layout::even_r, basic_point<int>{-2, 3}) == basic_offset<int>{0, 3}, "algorithmic error");
+static_assert( from_offset(offset_layout::even_q, basic_offset<int>{-3, 2}) == basic_point<int>{-3, 3}, "algorithmic error");
+static_assert( from_offset(offset_layout::odd_r, to_offset(offset_layout::odd_r, basic_point<int>{-5, -3})) == basic_point<int>{-5, -3}, "algorithmic error");
+
+
+/*
+indexed surface of the cells of a width x height offset rectangle.
+the index of a cell is its row-major position in the raster: row * width + col.
+*/
+template <typename T>
+class basic_offset_rectangle {
+public:
+  using value_type = basic_point<T>;
+  using index_type = std::size_t;
+  using offset_type = basic_offset<T>;
+
+  constexpr basic_offset_rectangle(std::size_t width, std::size_t height, offset_layout layout):
+    m_width{ width }, m_height{ height }, m_layout{ layout } {}
+
+  constexpr std::size_t width() const { return m_width; }
+  constexpr std::size_t height() const { return m_height; }
+  constexpr offset_layout layout() const { return m_layout; }
+
+  constexpr index_type size() const { return m_width * m_height; }
+
+  constexpr bool is_valid(index_type i) const { return i < size(); }
+
+  constexpr bool is_valid(value_type const& p) const {
+    auto const o = to_offset(m_layout, p);
+    return o.col >= 0 && o.row >= 0
+      && static_cast<std::size_t>(o.col) < m_width && static_cast<std::size_t>(o.row) < m_height;
+  }
+
+  constexpr value_type value_at(index_type i) const {
+    return from_offset(m_layout, offset_type{ static_cast<T>(i % m_width), static_cast<T>(i / m_width) });
+  }
+
+  // size() for cells out of the rectangle
+  constexpr index_type index_of(value_type const& p) const {
+    if (!is_valid(p)) return size();
+    auto const o = to_offset(m_layout, p);
+    return static_cast<std::size_t>(o.row) * m_width + static_cast<std::size_t>(o.col);
+  }
+
+private:
+  std::size_t m_width;
+  std::size_t m_height;
+  offset_layout m_layout;
+};
+
+
+/*
+map over external memory: values[row * width + col] is the value of the cell at (col, row).
+nothing is copied nor owned, values shall outlive the view. Value may be const for read only views.
+the index space is the one of bounds(), so algorithms taking (bounds, values) run on it directly.
+*/
+template <typename T, typename Value>
+class basic_offset_map_view {
+public:
+  using bounds_type = basic_offset_rectangle<T>;
+  using indexed_type = basic_point<T>;
+  using index_type = typename bounds_type::index_type;
+  using key_type = index_type;
+  using value_type = Value;
+
+  // values shall hold width * height elements
+  constexpr basic_offset_map_view(std::span<value_type> values, std::size_t width, std::size_t height, offset_layout layout):
+    m_bounds{ width, height, layout }, m_values{ values.first(width * height) } {}
+
+#if defined(__cpp_lib_mdspan)
+  // rows of a row-major 2D mdspan
+  constexpr basic_offset_map_view(std::mdspan<value_type, std::dextents<std::size_t, 2>> values, offset_layout layout):
+    basic_offset_map_view(
+      std::span<value_type>{ values.data_handle(), values.size() },
+      values.extent(1), values.extent(0), layout
+    ) {}
+#endif
+
+  constexpr bounds_type const& bounds() const { return m_bounds; }
+
+  constexpr auto area() const { return m_bounds.size(); }
+  constexpr auto size() const { return m_bounds.size(); }
+
+  auto indices() const { return std::views::iota(index_type{ 0 }, size()); }
+  auto positions() const {
+    return indices() | std::views::transform([this](index_type i) { return m_bounds.value_at(i); });
+  }
+
+  constexpr std::span<value_type> values() const { return m_values; }
+
+  constexpr bool is_valid(key_type i) const { return m_bounds.is_valid(i); }
+  constexpr bool is_valid(indexed_type const& p) const { return m_bounds.is_valid(p); }
+
+  // unchecked access
+  constexpr value_type& operator[](key_type i) const { return m_values[i]; }
+
+  constexpr value_type* optional(key_type i) const { return is_valid(i) ? &m_values[i] : nullptr; }
+  constexpr value_type* optional(indexed_type const& p) const { return optional(index_of(p)); }
+
+  constexpr value_type const& get(key_type i, value_type const& fallback) const { return is_valid(i) ? m_values[i] : fallback; }
+  constexpr value_type const& get(indexed_type const& p, value_type const& fallback) const { return get(index_of(p), fallback); }
+
+  // nullptr for cells out of the rectangle
+  template <typename V>
+  constexpr value_type* set(key_type i, V const& value) const {
+    if (!is_valid(i)) return nullptr;
+    return &(m_values[i] = value);
+  }
+
+  template <typename V>
+  constexpr value_type* set(indexed_type const& p, V const& value) const { return set(index_of(p), value); }
+
+  constexpr auto position_at(index_type i) const { return m_bounds.value_at(i); }
+  constexpr auto index_of(indexed_type const& p) const { return m_bounds.index_of(p); }
+
+private:
+  bounds_type m_bounds;
+  std::span<value_type> m_values;
+};
+
+
+namespace integers {
+using offset = basic_offset<base_type>;
+using offset_rectangle = basic_offset_rectangle<base_type>;
+
+template <typename Value>
+using offset_map_view = basic_offset_map_view<base_type, Value>;
+}
+
+} // namespace geometry::hex
+
+#endif
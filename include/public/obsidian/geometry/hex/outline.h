@@ -0,0 +1,189 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_OUTLINE_H
+#define OBSIDIAN_GEOMETRY_HEX_OUTLINE_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/neighbor.h>
+#include <obsidian/geometry/hex/hash.h>
+#include <obsidian/geometry/hex/xy.h>
+#include <obsidian/geometry/core/map.h>
+#include <obsidian/geometry/core/parallel.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// boundaries of cell sets as closed polylines in xy space.
+// edge k of a cell goes from its corner k to its corner k+1 (corners numbered as axis)
+// and is shared with its neighbor in neighborhood k.
+
+namespace geometry::hex {
+
+// closed polyline, the last point connects to the first.
+// outer boundaries turn counterclockwise, holes clockwise.
+struct outline {
+  std::vector<xy> points;
+  bool hole;
+};
+
+namespace details {
+
+/*
+walks the boundary loop starting with edge k of cell c, keeping the set on its left.
+at the end of edge k, if the neighbor in k+1 is in the set, the boundary continues
+on that neighbor with its edge k-1, otherwise on edge k+1 of the same cell.
+calls visit(cell, edge) for every edge of the loop.
+*/
+template <typename T, typename Contains, typename Visit>
+void walk_boundary(basic_point<T> c, int k, Contains && contains, Visit && visit) {
+  auto const start = c;
+  int const start_edge = k;
+  do {
+    visit(c, k);
+    auto const next = c | (neighborhood::i + (k + 1));
+    if (contains(next)) {
+      c = next;
+      k = static_cast<int>(axismod6(axis::q_pos, k - 1));
+    } else {
+      k = static_cast<int>(axismod6(axis::q_pos, k + 1));
+    }
+  } while (c != start || k != start_edge);
+}
+
+template <bool FlatTop, typename T>
+outline make_outline(std::vector<std::pair<basic_point<T>, int>> const& edges, double size) {
+  using orientation = Orientation<FlatTop>;
+  outline result{ {}, false };
+  result.points.reserve(edges.size());
+  for (auto const& [c, k] : edges) {
+    auto const center = orientation::to_xy(c);
+    auto const corner = orientation::corner_offset(axis::q_pos + (k + 1), size);
+    result.points.push_back({center.x * size + corner.x, center.y * size + corner.y});
+  }
+
+  // shoelace formula: negative area is clockwise
+  double area = 0;
+  for (std::size_t i = 0; i < result.points.size(); ++i) {
+    auto const& a = result.points[i];
+    auto const& b = result.points[(i + 1) % result.points.size()];
+    area += a.x * b.y - b.x * a.y;
+  }
+  result.hole = area < 0;
+  return result;
+}
+
+} // namespace details
+
+
+/*
+outlines of the cells whose bit is set (bit i of words being the cell at index i of bounds).
+cells are scanned once, each boundary loop is then walked along its edges only.
+
+with several threads, index tiles are scanned independently: a loop is kept by the tile
+holding its smallest (index, edge). loops are sorted by that edge so the output does not
+depend on the number of threads.
+*/
+template <bool FlatTop, typename Bounds>
+std::vector<outline> trace_outlines(
+  Bounds const& bounds,
+  std::span<std::uint64_t const> words,
+  Orientation<FlatTop>,
+  double size = 1,
+  unsigned threads = 1
+) {
+  using traits = core::indexed_surface_traits<Bounds>;
+  using index_type = typename traits::index_type;
+  using point_type = typename traits::value_type;
+  using edge_type = std::pair<point_type, int>;
+
+  index_type const area = traits::size(bounds);
+  auto const bit = [&](index_type i) { return ((words[i / 64] >> (i % 64)) & 1u) != 0; };
+  auto const contains = [&](point_type const& p) {
+    auto const i = traits::index_of(bounds, p);
+    return traits::is_valid(bounds, i) && bit(i);
+  };
+
+  // visited edges, 6 bits per cell. a tile only writes the bits of its own cells
+  std::vector<std::uint8_t> visited(area, 0);
+
+  std::size_t const tiles = threads <= 1 ? 1 : 4 * static_cast<std::size_t>(threads);
+  std::vector<std::vector<std::pair<std::pair<index_type, int>, outline>>> found(tiles);
+
+  core::parallel_for(tiles, threads, [&](std::size_t t) {
+    index_type const first = area * t / tiles;
+    index_type const last = area * (t + 1) / tiles;
+    auto const in_tile = [&](index_type i) { return first <= i && i < last; };
+
+    std::vector<edge_type> loop;
+    for (index_type i = first; i < last; ++i) {
+      if (!bit(i)) continue;
+      auto const p = traits::value_at(bounds, i);
+      for (int k = 0; k < 6; ++k) {
+        if ((visited[i] >> k) & 1u) continue;
+        if (contains(p | (neighborhood::i + k))) continue;
+
+        loop.clear();
+        std::pair<index_type, int> smallest{ i, k };
+        std::size_t smallest_at = 0;
+        details::walk_boundary(p, k, contains, [&](point_type const& c, int e) {
+          auto const j = traits::index_of(bounds, c);
+          if (in_tile(j)) visited[j] |= static_cast<std::uint8_t>(1u << e);
+          if (std::pair{j, e} < smallest) {
+            smallest = {j, e};
+            smallest_at = loop.size();
+          }
+          loop.emplace_back(c, e);
+        });
+
+        if (!in_tile(smallest.first)) continue;
+        std::ranges::rotate(loop, loop.begin() + static_cast<std::ptrdiff_t>(smallest_at));
+        found[t].emplace_back(smallest, details::make_outline<FlatTop>(loop, size));
+      }
+    }
+  });
+
+  std::vector<std::pair<std::pair<index_type, int>, outline>> all;
+  for (auto & f : found) std::ranges::move(f, std::back_inserter(all));
+  std::ranges::sort(all, {}, [](auto const& o) { return o.first; });
+
+  std::vector<outline> result;
+  result.reserve(all.size());
+  for (auto & o : all) result.push_back(std::move(o.second));
+  return result;
+}
+
+// outlines of the keys of a sparse map
+template <bool FlatTop, typename T, typename Value, typename Allocator>
+std::vector<outline> trace_outlines(
+  core::sparse_map<basic_point<T>, Value, Allocator> const& cells,
+  Orientation<FlatTop>,
+  double size = 1
+) {
+  using point_type = basic_point<T>;
+
+  std::unordered_map<point_type, std::uint8_t> visited;
+  auto const contains = [&](point_type const& p) { return cells.contains(p); };
+
+  std::vector<outline> result;
+  std::vector<std::pair<point_type, int>> loop;
+  for (auto const& p : cells.keys()) {
+    for (int k = 0; k < 6; ++k) {
+      if ((visited[p] >> k) & 1u) continue;
+      if (contains(p | (neighborhood::i + k))) continue;
+
+      loop.clear();
+      details::walk_boundary(p, k, contains, [&](point_type const& c, int e) {
+        visited[c] |= static_cast<std::uint8_t>(1u << e);
+        loop.emplace_back(c, e);
+      });
+      result.push_back(details::make_outline<FlatTop>(loop, size));
+    }
+  }
+  return result;
+}
+
+} // namespace geometry::hex
+
+#endif
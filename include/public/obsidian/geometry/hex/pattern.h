@@ -0,0 +1,276 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_PATTERN_H
+#define OBSIDIAN_GEOMETRY_HEX_PATTERN_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/disk.h>
+#include <obsidian/geometry/hex/disk_symmetry.h>
+#include <obsidian/geometry/hex/offset.h>
+#include <obsidian/geometry/core/map.h>
+#include <obsidian/geometry/core/parallel.h>
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// template search over maps, in any of the 12 orientations of the template.
+
+namespace geometry::hex {
+
+/*
+a pattern is a set of cells relative to an anchor.
+each cell has a test: either a predicate called with the map value,
+or a value compared with the map value.
+*/
+template <typename T, typename Test>
+struct pattern_cell {
+  basic_vector<T> offset;
+  Test test;
+};
+
+namespace details {
+
+template <typename Test, typename Value>
+constexpr bool accepts(Test const& test, Value const& value) {
+  if constexpr (std::is_invocable_r_v<bool, Test const&, Value const&>) {
+    return test(value);
+  } else {
+    return test == value;
+  }
+}
+
+template <typename T, typename Test>
+bool same_cells(std::vector<pattern_cell<T, Test>> a, std::vector<pattern_cell<T, Test>> b) {
+  auto const by_offset = [](auto const& x, auto const& y) {
+    return x.offset.q() != y.offset.q() ? x.offset.q() < y.offset.q() : x.offset.r() < y.offset.r();
+  };
+  std::ranges::sort(a, by_offset);
+  std::ranges::sort(b, by_offset);
+  return std::ranges::equal(a, b, [](auto const& x, auto const& y) {
+    return x.offset == y.offset && x.test == y.test;
+  });
+}
+
+} // namespace details
+
+
+// the distinct orientations of a pattern, cells keep their order so put the most selective first.
+template <typename T, typename Test>
+class compiled_pattern {
+public:
+  using vector_type = basic_vector<T>;
+  using cell_type = pattern_cell<T, Test>;
+
+  struct orientation {
+    symmetry transform;
+    std::vector<cell_type> cells;
+  };
+
+  explicit compiled_pattern(std::span<cell_type const> cells, bool with_reflections = true) {
+    for (auto const& s : symmetries) {
+      if (s.reflected && !with_reflections) continue;
+
+      orientation o{ s, {} };
+      o.cells.reserve(cells.size());
+      for (auto const& c : cells) o.cells.push_back({c.offset * s, c.test});
+
+      // tests which can't be compared (lambdas) keep every orientation
+      if constexpr (std::equality_comparable<Test>) {
+        bool const duplicate = std::ranges::any_of(m_orientations, [&o](orientation const& other){
+          return details::same_cells(o.cells, other.cells);
+        });
+        if (duplicate) continue;
+      }
+      m_orientations.push_back(std::move(o));
+    }
+
+    for (auto const& c : cells) m_radius = std::max<disk_radius>(m_radius, static_cast<disk_radius>(length(c.offset)));
+  }
+
+  compiled_pattern(std::initializer_list<cell_type> cells, bool with_reflections = true):
+    compiled_pattern(std::span<cell_type const>{cells.begin(), cells.size()}, with_reflections) {}
+
+  std::span<orientation const> orientations() const { return m_orientations; }
+
+  // largest distance between the anchor and a cell
+  disk_radius radius() const { return m_radius; }
+
+private:
+  std::vector<orientation> m_orientations;
+  disk_radius m_radius = 0;
+};
+
+
+template <typename Index>
+struct pattern_match {
+  Index anchor;
+  std::size_t orientation; // in compiled_pattern::orientations()
+};
+
+
+namespace details {
+
+// index slices of a surface scanned by one task: sectors for disks, chunks otherwise
+template <typename Bounds, typename F>
+void for_each_scan_task(Bounds const& bounds, unsigned threads, F && f) {
+  using traits = core::indexed_surface_traits<Bounds>;
+  using index_type = typename traits::index_type;
+
+  if constexpr (requires { { bounds.radius() } -> std::convertible_to<disk_radius>; }) {
+    // a few bands per thread so that sectors of unequal cost balance
+    auto const sectors = disk_sectors(bounds.radius(), (4 * threads + 5) / 6);
+    std::vector<disk_sector> tasks{ disk_sector{0, 0, 0} }; // the center alone
+    tasks.insert(tasks.end(), sectors.begin(), sectors.end());
+    auto const count = tasks.size();
+    f(count, [tasks = std::move(tasks)](std::size_t t, auto && visit) {
+      if (tasks[t].last_ring == 0) visit(index_type{0});
+      else for_each_index(tasks[t], visit);
+    });
+  } else {
+    index_type const size = traits::size(bounds);
+    std::size_t const count = std::max<std::size_t>(1, 4 * threads);
+    f(count, [size, count](std::size_t t, auto && visit) {
+      index_type const first = size * t / count;
+      index_type const last = size * (t + 1) / count;
+      for (index_type i = first; i < last; ++i) visit(i);
+    });
+  }
+}
+
+template <typename Index, typename F>
+std::vector<pattern_match<Index>> scan(auto const& bounds, unsigned threads, F && match_at) {
+  std::vector<pattern_match<Index>> result;
+  for_each_scan_task(bounds, threads, [&](std::size_t count, auto const& task) {
+    std::vector<std::vector<pattern_match<Index>>> found(count);
+    core::parallel_for(count, threads, [&](std::size_t t) {
+      task(t, [&](Index i){ match_at(i, found[t]); });
+    });
+    for (auto & f : found) result.insert(result.end(), f.begin(), f.end());
+  });
+  std::ranges::sort(result, [](auto const& a, auto const& b) {
+    return a.anchor != b.anchor ? a.anchor < b.anchor : a.orientation < b.orientation;
+  });
+  return result;
+}
+
+// matches over any map with bounds(), position_at(index) and optional(point)
+template <typename T, typename Test, typename Map>
+auto match_cells(compiled_pattern<T, Test> const& pattern, Map const& map, unsigned threads) {
+  using index_type = typename Map::index_type;
+  auto const orientations = pattern.orientations();
+
+  return scan<index_type>(map.bounds(), threads, [&](index_type i, auto & out) {
+    auto const p = map.position_at(i);
+    for (std::size_t o = 0; o < orientations.size(); ++o) {
+      bool const found = std::ranges::all_of(orientations[o].cells, [&](auto const& c) {
+        auto const* v = map.optional(p + c.offset);
+        return v != nullptr && accepts(c.test, *v);
+      });
+      if (found) out.push_back({i, o});
+    }
+  });
+}
+
+} // namespace details
+
+
+// every (anchor, orientation) where all cells of the pattern accept the map values
+template <typename T, typename Test, typename Bounds, typename Value, typename Allocator>
+auto find_matches(
+  compiled_pattern<T, Test> const& pattern,
+  core::indexed_dense_map<Bounds, Value, Allocator> const& map,
+  unsigned threads = 1
+) {
+  return details::match_cells(pattern, map, threads);
+}
+
+// same over external memory
+template <typename T, typename Test, typename U, typename Value>
+auto find_matches(
+  compiled_pattern<T, Test> const& pattern,
+  basic_offset_map_view<U, Value> const& view,
+  unsigned threads = 1
+) {
+  return details::match_cells(pattern, view, threads);
+}
+
+
+/*
+boolean patterns over a bitset: bit i of words is the value at index i of bounds.
+
+the cells of all orientations are gathered once per anchor into a 64 bits signature,
+then every orientation is a mask and expected bits: all of them are compared
+with a couple of word operations instead of cell by cell.
+patterns whose orientations span more than 64 cells are matched cell by cell.
+*/
+template <typename T, typename Bounds>
+auto find_matches(
+  compiled_pattern<T, bool> const& pattern,
+  Bounds const& bounds,
+  std::span<std::uint64_t const> words,
+  unsigned threads = 1
+) {
+  using traits = core::indexed_surface_traits<Bounds>;
+  using index_type = typename traits::index_type;
+  using vector_type = basic_vector<T>;
+
+  auto const orientations = pattern.orientations();
+
+  auto const bit = [&](index_type i) { return (words[i / 64] >> (i % 64)) & 1u; };
+
+  // union of the offsets of every orientation
+  std::vector<vector_type> offsets;
+  for (auto const& o : orientations) {
+    for (auto const& c : o.cells) {
+      if (std::ranges::find(offsets, c.offset) == offsets.end()) offsets.push_back(c.offset);
+    }
+  }
+
+  if (offsets.size() > 64) {
+    return details::scan<index_type>(bounds, threads, [&](index_type i, auto & out) {
+      auto const p = traits::value_at(bounds, i);
+      for (std::size_t o = 0; o < orientations.size(); ++o) {
+        bool const found = std::ranges::all_of(orientations[o].cells, [&](auto const& c) {
+          auto const j = traits::index_of(bounds, p + c.offset);
+          return traits::is_valid(bounds, j) && (bit(j) != 0) == c.test;
+        });
+        if (found) out.push_back({i, o});
+      }
+    });
+  }
+
+  struct signature { std::uint64_t mask = 0; std::uint64_t expected = 0; };
+  std::vector<signature> signatures;
+  for (auto const& o : orientations) {
+    signature s;
+    for (auto const& c : o.cells) {
+      auto const b = std::uint64_t{1} << (std::ranges::find(offsets, c.offset) - offsets.begin());
+      s.mask |= b;
+      if (c.test) s.expected |= b;
+    }
+    signatures.push_back(s);
+  }
+
+  return details::scan<index_type>(bounds, threads, [&](index_type i, auto & out) {
+    auto const p = traits::value_at(bounds, i);
+    std::uint64_t valid = 0;
+    std::uint64_t values = 0;
+    for (std::size_t k = 0; k < offsets.size(); ++k) {
+      auto const j = traits::index_of(bounds, p + offsets[k]);
+      if (!traits::is_valid(bounds, j)) continue;
+      valid |= std::uint64_t{1} << k;
+      values |= static_cast<std::uint64_t>(bit(j)) << k;
+    }
+    for (std::size_t o = 0; o < signatures.size(); ++o) {
+      auto const& s = signatures[o];
+      if ((s.mask & ~valid) == 0 && ((values ^ s.expected) & s.mask) == 0) out.push_back({i, o});
+    }
+  });
+}
+
+} // namespace geometry::hex
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_RASTERIZE_H
+#define OBSIDIAN_GEOMETRY_HEX_RASTERIZE_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/neighbor.h>
+#include <obsidian/geometry/hex/round.h>
+#include <obsidian/geometry/hex/rows.h>
+#include <obsidian/geometry/hex/xy.h>
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <vector>
+
+// see https://www.redblobgames.com/grids/hexagons/#pixel-to-hex
+
+// polygons in xy space to hex cells.
+// from_xy is linear, so a polygon keeps straight edges in fractional q/r space:
+// rows of cells are the lines r = constant, and cell centers the integer q along them.
+// filling is then a classic scanline over those rows, walking the edges row by row.
+
+namespace geometry::hex {
+
+enum struct coverage {
+  center,  // cells whose center is inside the polygon
+  overlap, // cells sharing some area with the polygon
+};
+
+namespace details {
+
+struct scan_edge {
+  double r_low, q_low; // lower end in r
+  double slope;        // dq/dr
+  double first_row, last_row;
+};
+
+// calls visit(cell) for every cell crossed by segment [a, b], from the cell of a to the cell of b.
+template <typename T, bool FlatTop, typename Visit>
+void trace_segment(xy const& a, xy const& b, Orientation<FlatTop>, Visit && visit) {
+  using orientation = Orientation<FlatTop>;
+
+  auto cell = round<T>(orientation::from_xy(a));
+  auto const last = round<T>(orientation::from_xy(b));
+  visit(cell);
+
+  xy const d{ b.x - a.x, b.y - a.y };
+  auto const cross = [](xy const& u, xy const& v) { return u.x * v.y - u.y * v.x; };
+
+  double t = 0;
+  // each step leaves a cell through one of its edges, more steps would be a numerical loop
+  for (auto steps = 2 * distance(cell, last) + 2; cell != last && steps > 0; --steps) {
+    auto const center = orientation::to_xy(cell);
+
+    // exit edge: the edge crossed with the largest parameter. edge k is shared with neighborhood k
+    double exit = t;
+    int side = -1;
+    for (int k = 0; k < 6; ++k) {
+      auto const c0 = center + orientation::corner_offset(axis::q_pos + k);
+      auto const c1 = center + orientation::corner_offset(axis::q_pos + (k + 1));
+      xy const e{ c1.x - c0.x, c1.y - c0.y };
+      xy const w{ c0.x - a.x, c0.y - a.y };
+      auto const denominator = cross(d, e);
+      if (denominator == 0) continue;
+      auto const s = cross(w, e) / denominator;
+      auto const u = cross(w, d) / denominator;
+      if (u < 0 || u > 1 || s <= exit) continue;
+      exit = s;
+      side = k;
+    }
+    if (side < 0) break;
+
+    t = exit;
+    cell |= neighborhood::i + side;
+    visit(cell);
+  }
+}
+
+} // namespace details
+
+
+/*
+calls emit(run) for the runs of cells covered by the polygon, by increasing r then q.
+the polygon is closed (last vertex connects to the first) and filled with the even-odd rule.
+with coverage::center, the cost is the number of rows times the edges crossing them plus the output;
+coverage::overlap also walks the cells crossed by every edge.
+*/
+template <typename T = integers::base_type, bool FlatTop, typename Emit>
+void rasterize(std::span<xy const> polygon, Orientation<FlatTop> orientation, coverage mode, Emit && emit) {
+  using run_type = basic_row_run<T>;
+
+  if (polygon.empty()) return;
+
+  std::vector<details::scan_edge> edges;
+  edges.reserve(polygon.size());
+  for (std::size_t i = 0; i < polygon.size(); ++i) {
+    auto a = orientation.from_xy(polygon[i]);
+    auto b = orientation.from_xy(polygon[(i + 1) % polygon.size()]);
+    if (a.r() == b.r()) continue;
+    if (b.r() < a.r()) std::swap(a, b);
+
+    // rows r with a.r <= r < b.r
+    auto const first = std::ceil(a.r());
+    auto const last = std::ceil(b.r()) - 1;
+    if (last < first) continue;
+    edges.push_back({a.r(), a.q(), (b.q() - a.q()) / (b.r() - a.r()), first, last});
+  }
+  std::ranges::sort(edges, {}, &details::scan_edge::first_row);
+
+  std::vector<run_type> overlap_runs;
+  auto const output = [&](run_type const& run) {
+    if (mode == coverage::center) emit(run);
+    else overlap_runs.push_back(run);
+  };
+
+  // active edge table
+  std::vector<details::scan_edge const*> active;
+  std::vector<double> crossings;
+  std::size_t next = 0;
+  while (next < edges.size()) {
+    // jump over rows without edges
+    for (double r = edges[next].first_row; ; ++r) {
+      while (next < edges.size() && edges[next].first_row <= r) active.push_back(&edges[next++]);
+      std::erase_if(active, [r](auto const* e){ return e->last_row < r; });
+      if (active.empty()) break;
+
+      crossings.clear();
+      for (auto const* e : active) crossings.push_back(e->q_low + (r - e->r_low) * e->slope);
+      std::ranges::sort(crossings);
+
+      // centers q with crossing[2k] <= q < crossing[2k+1]
+      for (std::size_t k = 0; k + 1 < crossings.size(); k += 2) {
+        auto const q_begin = static_cast<T>(std::ceil(crossings[k]));
+        auto const q_end = static_cast<T>(std::ceil(crossings[k + 1]));
+        if (q_begin < q_end) output(run_type{static_cast<T>(r), q_begin, q_end});
+      }
+    }
+  }
+
+  if (mode == coverage::center) return;
+
+  for (std::size_t i = 0; i < polygon.size(); ++i) {
+    details::trace_segment<T>(polygon[i], polygon[(i + 1) % polygon.size()], orientation,
+      [&](basic_point<T> const& p) { overlap_runs.push_back(run_type{p.r(), p.q(), p.q() + 1}); });
+  }
+  normalize(overlap_runs);
+  for (auto const& run : overlap_runs) emit(run);
+}
+
+template <typename T = integers::base_type, bool FlatTop>
+std::vector<basic_row_run<T>> rasterize(std::span<xy const> polygon, Orientation<FlatTop> orientation, coverage mode = coverage::center) {
+  std::vector<basic_row_run<T>> runs;
+  rasterize<T>(polygon, orientation, mode, [&runs](basic_row_run<T> const& run){ runs.push_back(run); });
+  return runs;
+}
+
+} // namespace geometry::hex
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_REGION_H
+#define OBSIDIAN_GEOMETRY_HEX_REGION_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/rows.h>
+#include <obsidian/geometry/hex/rasterize.h>
+#include <obsidian/geometry/hex/xy.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <vector>
+
+// see https://www.redblobgames.com/grids/hexagons/#map-storage
+
+// sets of cells stored as runs (see rows.h): sorted by r then q, never overlapping nor touching.
+// a region of n runs costs O(n) memory whatever its area, and boolean operations merge
+// the runs of both operands in a single pass, O(n + m).
+
+namespace geometry::hex {
+
+namespace details {
+
+// k-th boundary of normalized runs: q_begin of run k/2 when k is even, its q_end otherwise
+template <typename T>
+constexpr T run_boundary(std::span<basic_row_run<T> const> runs, std::size_t k) {
+  return k % 2 == 0 ? runs[k / 2].q_begin : runs[k / 2].q_end;
+}
+
+/*
+runs of the cells where keep(in a, in b) holds, keep(false, false) being false.
+every row is swept along q over the boundaries of both operands: inside a run of an operand
+between its even and odd boundaries, a run is emitted each time keep stops holding.
+*/
+template <typename T, typename Keep>
+std::vector<basic_row_run<T>> combine_runs(
+  std::span<basic_row_run<T> const> a,
+  std::span<basic_row_run<T> const> b,
+  Keep keep
+) {
+  constexpr T none = std::numeric_limits<T>::max();
+  std::vector<basic_row_run<T>> result;
+
+  std::size_t i = 0, j = 0;
+  while (i < a.size() || j < b.size()) {
+    T const r = j == b.size() || (i < a.size() && a[i].r < b[j].r) ? a[i].r : b[j].r;
+
+    auto i_end = i, j_end = j;
+    while (i_end < a.size() && a[i_end].r == r) ++i_end;
+    while (j_end < b.size() && b[j_end].r == r) ++j_end;
+    auto const row_a = a.subspan(i, i_end - i);
+    auto const row_b = b.subspan(j, j_end - j);
+
+    std::size_t ka = 0, kb = 0;
+    bool inside = false;
+    T begin = 0;
+    while (ka < 2 * row_a.size() || kb < 2 * row_b.size()) {
+      T const next_a = ka < 2 * row_a.size() ? run_boundary(row_a, ka) : none;
+      T const next_b = kb < 2 * row_b.size() ? run_boundary(row_b, kb) : none;
+      T const q = std::min(next_a, next_b);
+      if (next_a == q) ++ka;
+      if (next_b == q) ++kb;
+
+      bool const now = keep(ka % 2 == 1, kb % 2 == 1);
+      if (now == inside) continue;
+      if (now) begin = q;
+      else result.push_back({r, begin, q});
+      inside = now;
+    }
+
+    i = i_end;
+    j = j_end;
+  }
+  return result;
+}
+
+} // namespace details
+
+
+template <typename T>
+class basic_region {
+public:
+  using value_type = basic_point<T>;
+  using run_type = basic_row_run<T>;
+
+  basic_region() = default;
+
+  // runs in any order, possibly overlapping
+  explicit basic_region(std::vector<run_type> runs): m_runs{ std::move(runs) } {
+    normalize(m_runs);
+  }
+
+  template <std::ranges::input_range Points>
+  static basic_region from_points(Points && points) {
+    std::vector<run_type> runs;
+    if constexpr (std::ranges::sized_range<Points>) runs.reserve(std::ranges::size(points));
+    for (value_type const& p : points) runs.push_back({ p.r(), p.q(), p.q() + 1 });
+    return basic_region{ std::move(runs) };
+  }
+
+  // cells at distance <= radius of center
+  static basic_region disk(value_type const& center, T radius) {
+    basic_region result;
+    if (radius < 0) return result;
+    result.m_runs.reserve(static_cast<std::size_t>(2 * radius + 1));
+    for (T dr = -radius; dr <= radius; ++dr) {
+      auto const row = disk_row(radius, dr);
+      result.m_runs.push_back({ center.r() + dr, center.q() + row.q_begin, center.q() + row.q_end });
+    }
+    return result;
+  }
+
+  // cells at distance radius of center: whole first and last rows, and both ends of the others
+  static basic_region ring(value_type const& center, T radius) {
+    if (radius <= 0) return disk(center, radius);
+    basic_region result;
+    result.m_runs.reserve(static_cast<std::size_t>(4 * radius));
+    for (T dr = -radius; dr <= radius; ++dr) {
+      auto const row = disk_row(radius, dr);
+      T const first = center.q() + row.q_begin, last = center.q() + row.q_end - 1;
+      if (dr == -radius || dr == radius) {
+        result.m_runs.push_back({ center.r() + dr, first, last + 1 });
+      } else {
+        result.m_runs.push_back({ center.r() + dr, first, first + 1 });
+        result.m_runs.push_back({ center.r() + dr, last, last + 1 });
+      }
+    }
+    return result;
+  }
+
+  // cells of a polygon in xy space, see rasterize.h
+  template <bool FlatTop>
+  static basic_region polygon(std::span<xy const> vertices, Orientation<FlatTop> orientation, coverage mode = coverage::center) {
+    return basic_region{ rasterize<T>(vertices, orientation, mode) };
+  }
+
+
+  std::span<run_type const> runs() const { return m_runs; }
+
+  bool empty() const { return m_runs.empty(); }
+
+  // count of cells
+  std::size_t area() const {
+    std::size_t result = 0;
+    for (auto const& run : m_runs) result += static_cast<std::size_t>(run.size());
+    return result;
+  }
+
+  // O(log runs)
+  bool contains(value_type const& p) const {
+    auto const it = std::ranges::upper_bound(m_runs, run_type{ p.r(), p.q(), p.q() }, std::less<>{});
+    return it != m_runs.begin() && std::prev(it)->contains(p);
+  }
+
+  // cells by increasing r then q
+  auto points() const {
+    return m_runs | std::views::transform([](run_type const& run) { return run.points(); }) | std::views::join;
+  }
+
+
+  friend basic_region operator|(basic_region const& a, basic_region const& b) {
+    return combine(a, b, [](bool x, bool y) { return x || y; });
+  }
+
+  friend basic_region operator&(basic_region const& a, basic_region const& b) {
+    return combine(a, b, [](bool x, bool y) { return x && y; });
+  }
+
+  friend basic_region operator-(basic_region const& a, basic_region const& b) {
+    return combine(a, b, [](bool x, bool y) { return x && !y; });
+  }
+
+  friend basic_region operator^(basic_region const& a, basic_region const& b) {
+    return combine(a, b, [](bool x, bool y) { return x != y; });
+  }
+
+  basic_region& operator|=(basic_region const& b) { return *this = *this | b; }
+  basic_region& operator&=(basic_region const& b) { return *this = *this & b; }
+  basic_region& operator-=(basic_region const& b) { return *this = *this - b; }
+  basic_region& operator^=(basic_region const& b) { return *this = *this ^ b; }
+
+  friend bool operator==(basic_region const& a, basic_region const& b) { return a.m_runs == b.m_runs; }
+
+private:
+  template <typename Keep>
+  static basic_region combine(basic_region const& a, basic_region const& b, Keep keep) {
+    basic_region result;
+    result.m_runs = details::combine_runs<T>(a.runs(), b.runs(), keep);
+    return result;
+  }
+
+  std::vector<run_type> m_runs;
+};
+
+
+namespace integers {
+using region = basic_region<base_type>;
+}
+
+} // namespace geometry::hex
+
+#endif
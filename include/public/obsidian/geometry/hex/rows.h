@@ -0,0 +1,91 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_ROWS_H
+#define OBSIDIAN_GEOMETRY_HEX_ROWS_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+
+#include <algorithm>
+#include <ranges>
+#include <vector>
+
+// see https://www.redblobgames.com/grids/hexagons/#map-storage
+
+// a row is the set of cells sharing the same r, q going along it.
+// shapes are described as runs: contiguous q ranges of a row.
+
+namespace geometry::hex {
+
+// cells <q, r> for q in [q_begin, q_end)
+template <typename T>
+struct basic_row_run {
+  using value_type = T;
+
+  T r;
+  T q_begin;
+  T q_end;
+
+  constexpr T size() const { return q_end - q_begin; }
+  constexpr bool empty() const { return q_end <= q_begin; }
+
+  constexpr bool contains(basic_point<T> const& p) const {
+    return p.r() == r && q_begin <= p.q() && p.q() < q_end;
+  }
+
+  auto points() const {
+    return std::views::iota(q_begin, std::max(q_begin, q_end))
+      | std::views::transform([r = this->r](T q){ return basic_point<T>{q, r}; });
+  }
+};
+
+template <typename T>
+constexpr bool operator==(basic_row_run<T> const& a, basic_row_run<T> const& b) {
+  return a.r == b.r && a.q_begin == b.q_begin && a.q_end == b.q_end;
+}
+
+// rows first, then q
+template <typename T>
+constexpr bool operator<(basic_row_run<T> const& a, basic_row_run<T> const& b) {
+  return a.r != b.r ? a.r < b.r : a.q_begin < b.q_begin;
+}
+
+// sorts runs and merges those overlapping or touching
+template <typename T>
+void normalize(std::vector<basic_row_run<T>> & runs) {
+  std::erase_if(runs, [](auto const& run){ return run.empty(); });
+  std::ranges::sort(runs, std::less<>{});
+
+  std::size_t out = 0;
+  for (std::size_t i = 0; i < runs.size(); ++i) {
+    if (out > 0 && runs[out - 1].r == runs[i].r && runs[i].q_begin <= runs[out - 1].q_end) {
+      runs[out - 1].q_end = std::max(runs[out - 1].q_end, runs[i].q_end);
+    } else {
+      runs[out++] = runs[i];
+    }
+  }
+  runs.resize(out);
+}
+
+// common part of two runs (empty if they are on different rows)
+template <typename T>
+constexpr basic_row_run<T> intersection(basic_row_run<T> const& a, basic_row_run<T> const& b) {
+  if (a.r != b.r) return {a.r, a.q_begin, a.q_begin};
+  return {a.r, std::max(a.q_begin, b.q_begin), std::max(std::max(a.q_begin, b.q_begin), std::min(a.q_end, b.q_end))};
+}
+
+// row r of the disk of given radius around the origin: q in [max(-R, -r-R), min(R, -r+R)]
+template <typename T>
+constexpr basic_row_run<T> disk_row(T radius, T r) {
+  if (r < -radius || r > radius) return {r, 0, 0};
+  return {r, std::max(-radius, -r - radius), std::min(radius, -r + radius) + 1};
+}
+
+static_assert( disk_row(2, 0).q_begin == -2 && disk_row(2, 0).q_end == 3, "algorithmic error");
+static_assert( disk_row(2, 1).q_begin == -2 && disk_row(2, 1).q_end == 2, "algorithmic error");
+static_assert( disk_row(2, -2).q_begin == 0 && disk_row(2, -2).q_end == 3, "algorithmic error");
+
+namespace integers {
+using row_run = basic_row_run<base_type>;
+}
+
+} // namespace geometry::hex
+
+#endif
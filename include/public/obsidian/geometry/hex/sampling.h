@@ -0,0 +1,54 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_SAMPLING_H
+#define OBSIDIAN_GEOMETRY_HEX_SAMPLING_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/disk.h>
+#include <obsidian/geometry/core/sampling.h>
+#include <obsidian/geometry/core/surface.h>
+
+#include <cstddef>
+#include <vector>
+
+// random cells around a point, see core/sampling.h for the draws.
+
+namespace geometry::hex {
+
+// k distinct cells at distance at most radius from center, by increasing spiral index around center
+template <typename T, typename URBG>
+std::vector<basic_point<T>> sample_within(basic_point<T> const& center, disk_radius radius, std::size_t k, URBG & g) {
+  std::vector<basic_point<T>> result;
+  auto const indices = core::sample_indices<disk_index>(disk_size(radius), k, g);
+  result.reserve(indices.size());
+  for (auto const i : indices) result.push_back(center + details::vector_in_disk<T>(radius, i));
+  return result;
+}
+
+// same, restricted to the valid cells of an indexed surface: result by increasing index of the surface
+template <typename IndexedSurface, typename T, typename URBG>
+std::vector<typename core::indexed_surface_traits<IndexedSurface>::value_type> sample_within(
+  IndexedSurface const& surface,
+  basic_point<T> const& center,
+  disk_radius radius,
+  std::size_t k,
+  URBG & g
+) {
+  using traits = core::indexed_surface_traits<IndexedSurface>;
+  using index_type = typename traits::index_type;
+
+  std::vector<index_type> candidates;
+  for (auto const& p : spiral_around(center, radius)) {
+    auto const i = traits::index_of(surface, p);
+    if (traits::is_valid(surface, i)) candidates.push_back(i);
+  }
+  std::ranges::sort(candidates);
+
+  std::vector<typename traits::value_type> result;
+  auto const picked = core::sample_indices<std::size_t>(candidates.size(), k, g);
+  result.reserve(picked.size());
+  for (auto const i : picked) result.push_back(traits::value_at(surface, candidates[i]));
+  return result;
+}
+
+} // namespace geometry::hex
+
+#endif
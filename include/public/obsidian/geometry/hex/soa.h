@@ -0,0 +1,200 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_SOA_H
+#define OBSIDIAN_GEOMETRY_HEX_SOA_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/rotation.h>
+
+#include <vector>
+#include <span>
+#include <ranges>
+#include <array>
+#include <cstddef>
+
+// see https://www.redblobgames.com/grids/hexagons/
+// and https://www.redblobgames.com/grids/hexagons/implementation.html
+
+// structure of arrays storage for many points: q and r live in separate columns.
+// batch operations are plain indexed loops over the columns, without branches,
+// so that the compiler can auto-vectorize them.
+
+namespace geometry::hex {
+
+namespace details {
+
+// get(a) == q * coefficients[a][0] + r * coefficients[a][1]
+constexpr std::array<std::array<int, 2>, 6> axis_coefficients {{
+  { 1, 0}, // q_pos
+  { 1, 1}, // s_neg
+  { 0, 1}, // r_pos
+  {-1, 0}, // q_neg
+  {-1,-1}, // s_pos
+  { 0,-1}, // r_neg
+}};
+
+// rotation as a 2x2 matrix: q' = qq*q + qr*r, r' = rq*q + rr*r
+struct rotation_matrix {
+  int qq, qr, rq, rr;
+};
+
+constexpr rotation_matrix matrix_of(integral_rotation const& rotation) {
+  // same as operator*(basic_vector, integral_rotation)
+  auto const& q = axis_coefficients[static_cast<int>(axis::q_pos - rotation.steps)];
+  auto const& r = axis_coefficients[static_cast<int>(axis::r_pos - rotation.steps)];
+  return {q[0], q[1], r[0], r[1]};
+}
+
+static_assert( matrix_of(1_ccw).qq == 0 && matrix_of(1_ccw).qr == -1, "algorithmic error");
+static_assert( matrix_of(1_ccw).rq == 1 && matrix_of(1_ccw).rr == 1, "algorithmic error");
+
+// branch free cell hops length of <q, r>
+template <typename T>
+constexpr T hex_length(T q, T r) {
+  return maximum(maximum(absolute(q), absolute(r)), absolute(q + r));
+}
+
+} // namespace details
+
+
+template <typename T>
+class basic_point_soa {
+public:
+  using value_type = basic_point<T>;
+  using vector_type = basic_vector<T>;
+  using coordinate_type = T;
+  using size_type = std::size_t;
+
+  basic_point_soa() = default;
+  explicit basic_point_soa(size_type size): m_q(size), m_r(size) {}
+
+  template <std::ranges::input_range Points>
+  explicit basic_point_soa(Points && points) {
+    if constexpr (std::ranges::sized_range<Points>) reserve(std::ranges::size(points));
+    for (auto const& p : points) push_back(p);
+  }
+
+  size_type size() const { return m_q.size(); }
+  bool empty() const { return m_q.empty(); }
+
+  void reserve(size_type n) { m_q.reserve(n); m_r.reserve(n); }
+  void resize(size_type n) { m_q.resize(n); m_r.resize(n); }
+  void clear() { m_q.clear(); m_r.clear(); }
+
+  void push_back(value_type const& p) {
+    m_q.push_back(p.q());
+    m_r.push_back(p.r());
+  }
+
+  value_type operator[](size_type i) const { return {m_q[i], m_r[i]}; }
+
+  void set(size_type i, value_type const& p) {
+    m_q[i] = p.q();
+    m_r[i] = p.r();
+  }
+
+  std::span<T const> q() const { return m_q; }
+  std::span<T> q() { return m_q; }
+  std::span<T const> r() const { return m_r; }
+  std::span<T> r() { return m_r; }
+
+  auto points() const {
+    return std::views::iota(static_cast<size_type>(0), size())
+      | std::views::transform([this](size_type i){ return (*this)[i]; });
+  }
+
+
+  // batch algebra
+
+  void translate(vector_type const& v) {
+    T * __restrict q = m_q.data();
+    T * __restrict r = m_r.data();
+    T const dq = v.q();
+    T const dr = v.r();
+    size_type const n = size();
+    for (size_type i = 0; i < n; ++i) {
+      q[i] += dq;
+      r[i] += dr;
+    }
+  }
+
+  // counterclockwise rotation around center
+  void rotate(integral_rotation const& rotation, value_type const& center = origin<T>) {
+    auto const m = details::matrix_of(rotation);
+    T * __restrict q = m_q.data();
+    T * __restrict r = m_r.data();
+    T const cq = center.q();
+    T const cr = center.r();
+    size_type const n = size();
+    for (size_type i = 0; i < n; ++i) {
+      T const vq = q[i] - cq;
+      T const vr = r[i] - cr;
+      q[i] = cq + static_cast<T>(m.qq) * vq + static_cast<T>(m.qr) * vr;
+      r[i] = cr + static_cast<T>(m.rq) * vq + static_cast<T>(m.rr) * vr;
+    }
+  }
+
+  // out[i] = distance(p, (*this)[i]), out shall hold size() elements
+  void distance(value_type const& p, std::span<T> out) const {
+    T const * __restrict q = m_q.data();
+    T const * __restrict r = m_r.data();
+    T * __restrict o = out.data();
+    T const pq = p.q();
+    T const pr = p.r();
+    size_type const n = size();
+    for (size_type i = 0; i < n; ++i) {
+      o[i] = details::hex_length(q[i] - pq, r[i] - pr);
+    }
+  }
+
+  std::vector<T> distance(value_type const& p) const {
+    std::vector<T> out(size());
+    distance(p, out);
+    return out;
+  }
+
+  // out[i] = distance(origin, (*this)[i]), out shall hold size() elements
+  void length(std::span<T> out) const { distance(origin<T>, out); }
+
+  std::vector<T> length() const { return distance(origin<T>); }
+
+  // appends to out the indices i such that distance(p, (*this)[i]) <= radius
+  void within(value_type const& p, T radius, std::vector<size_type> & out) const {
+    T const * __restrict q = m_q.data();
+    T const * __restrict r = m_r.data();
+    T const pq = p.q();
+    T const pr = p.r();
+    size_type const n = size();
+
+    // branch free compaction: write every index, only advance on hits
+    size_type count = out.size();
+    out.resize(count + n);
+    size_type * __restrict o = out.data();
+    for (size_type i = 0; i < n; ++i) {
+      o[count] = i;
+      count += details::hex_length(q[i] - pq, r[i] - pr) <= radius;
+    }
+    out.resize(count);
+  }
+
+  std::vector<size_type> within(value_type const& p, T radius) const {
+    std::vector<size_type> out;
+    within(p, radius, out);
+    return out;
+  }
+
+private:
+  std::vector<T> m_q;
+  std::vector<T> m_r;
+};
+
+
+namespace integers {
+using point_soa = basic_point_soa<base_type>;
+}
+
+namespace doubles {
+using point_soa = basic_point_soa<base_type>;
+}
+
+} // namespace geometry::hex
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_SPIRAL_MAP_H
+#define OBSIDIAN_GEOMETRY_HEX_SPIRAL_MAP_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/disk.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <ranges>
+#include <vector>
+
+// see https://www.redblobgames.com/grids/hexagons/#map-storage
+
+/*
+dense map over a disk around the origin, growing ring by ring without bounds.
+the spiral index of a cell (disk_index_of) does not depend on the disk radius,
+so cells keep their index, and their value its address, when the map grows.
+
+values live in blocks of doubling sizes, as a stable vector: block b holds the indices
+[base * (2^b - 1), base * (2^(b+1) - 1)). finding a block is a bit_width, and growing
+allocates a new block without moving the previous ones (amortized O(1) per cell).
+*/
+
+namespace geometry::hex {
+
+template <typename T, typename Value>
+class basic_spiral_map {
+public:
+  using point_type = basic_point<T>;
+  using index_type = disk_index;
+  using key_type = index_type;
+  using indexed_type = point_type;
+  using value_type = Value;
+  using radius_type = disk_radius;
+
+  // cells of the first block
+  static constexpr std::size_t base_block = 64;
+
+  explicit basic_spiral_map(radius_type radius = 0, value_type const& fill = value_type{}): m_fill{ fill } {
+    grow(radius);
+  }
+
+  radius_type radius() const { return m_radius; }
+  index_type size() const { return disk_size(m_radius); }
+  auto area() const { return size(); }
+
+  // cells allocated, disk_size(radius()) <= capacity()
+  std::size_t capacity() const { return base_block * ((std::size_t{ 1 } << m_blocks.size()) - 1); }
+
+  // disk of the mapped cells, as bounds of indexed algorithms
+  basic_disk<T> bounds() const { return basic_disk<T>{ m_radius }; }
+
+  // adds rings up to radius, new cells holding the fill value
+  void grow(radius_type radius) {
+    if (radius <= m_radius && !m_blocks.empty()) return;
+    auto const needed = disk_size(radius);
+    while (capacity() < needed) {
+      m_blocks.emplace_back(base_block << m_blocks.size(), m_fill);
+    }
+    m_radius = std::max(m_radius, radius);
+  }
+
+  // grows so that p is mapped
+  void grow_to(point_type const& p) { grow(static_cast<radius_type>(length(p - origin<T>))); }
+
+  auto indices() const { return std::views::iota(index_type{ 0 }, size()); }
+  auto positions() const {
+    return indices() | std::views::transform([](index_type i) { return position_at(i); });
+  }
+
+  static point_type position_at(index_type i) {
+    return origin<T> + details::vector_in_disk<T>(ring_radius_of(i), i);
+  }
+
+  static index_type index_of(point_type const& p) { return details::disk_index_of(p - origin<T>); }
+
+  bool is_valid(index_type i) const { return i < size(); }
+  bool is_valid(point_type const& p) const { return static_cast<radius_type>(length(p - origin<T>)) <= m_radius; }
+
+  // unchecked access
+  value_type const& operator[](index_type i) const { return locate(i); }
+  value_type& operator[](index_type i) { return locate(i); }
+
+  value_type const* optional(index_type i) const { return is_valid(i) ? &locate(i) : nullptr; }
+  value_type* optional(index_type i) { return is_valid(i) ? &locate(i) : nullptr; }
+  value_type const* optional(point_type const& p) const { return is_valid(p) ? &locate(index_of(p)) : nullptr; }
+  value_type* optional(point_type const& p) { return is_valid(p) ? &locate(index_of(p)) : nullptr; }
+
+  value_type const& get(index_type i, value_type const& fallback) const { return is_valid(i) ? locate(i) : fallback; }
+  value_type const& get(point_type const& p, value_type const& fallback) const { return is_valid(p) ? locate(index_of(p)) : fallback; }
+
+  // maps p, growing the map when p is out of it
+  value_type& set(point_type const& p, value_type const& value) {
+    grow_to(p);
+    return locate(index_of(p)) = value;
+  }
+
+  // value of p, growing the map when p is out of it
+  value_type& at(point_type const& p) {
+    grow_to(p);
+    return locate(index_of(p));
+  }
+
+  // mapped cells only: rings added later still hold the fill value given at construction
+  void fill(value_type const& value) {
+    for_each([&](index_type, value_type & v) { v = value; });
+  }
+
+  // f(index, value) for every mapped cell, by increasing index, a block at a time
+  template <typename F>
+  void for_each(F && f) const { visit(*this, f); }
+
+  template <typename F>
+  void for_each(F && f) { visit(*this, f); }
+
+private:
+  static std::size_t block_of(index_type i) {
+    return static_cast<std::size_t>(std::bit_width(i / base_block + 1)) - 1;
+  }
+
+  value_type const& locate(index_type i) const {
+    auto const b = block_of(i);
+    return m_blocks[b][i - base_block * ((std::size_t{ 1 } << b) - 1)];
+  }
+
+  value_type& locate(index_type i) {
+    auto const b = block_of(i);
+    return m_blocks[b][i - base_block * ((std::size_t{ 1 } << b) - 1)];
+  }
+
+  template <typename Self, typename F>
+  static void visit(Self & self, F & f) {
+    index_type i = 0;
+    auto const size = self.size();
+    for (auto & block : self.m_blocks) {
+      for (auto & value : block) {
+        if (i == size) return;
+        f(i++, value);
+      }
+    }
+  }
+
+  // blocks are never resized, so values never move
+  std::vector<std::vector<value_type>> m_blocks;
+  radius_type m_radius = 0;
+  value_type m_fill;
+};
+
+namespace integers {
+template <typename Value>
+using spiral_map = basic_spiral_map<base_type, Value>;
+}
+
+} // namespace geometry::hex
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef OBSIDIAN_GEOMETRY_HEX_VIEWPORT_H
+#define OBSIDIAN_GEOMETRY_HEX_VIEWPORT_H
+
+#include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/disk.h>
+#include <obsidian/geometry/hex/rasterize.h>
+#include <obsidian/geometry/hex/rows.h>
+#include <obsidian/geometry/hex/xy.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+// cells visible through a screen rectangle, so that drawing costs the viewport and not the map.
+
+namespace geometry::hex {
+
+// half open range of indices
+struct index_range {
+  disk_index begin;
+  disk_index end;
+};
+
+constexpr bool operator==(index_range const& a, index_range const& b) {
+  return a.begin == b.begin && a.end == b.end;
+}
+
+/*
+runs of the cells sharing some area with the screen rectangle between two opposite corners.
+the rectangle is brought back to xy space, then rasterized with coverage::overlap.
+*/
+template <typename T = integers::base_type, typename Point2D, bool FlatTop>
+std::vector<basic_row_run<T>> visible_runs(
+  screen::ScreenTransformation<Point2D> const& screen,
+  Point2D const& corner,
+  Point2D const& opposite_corner,
+  Orientation<FlatTop> orientation
+) {
+  using traits = typename screen::ScreenTransformation<Point2D>::traits;
+  std::array<xy, 4> const rectangle{
+    screen.from_screen(traits::x(corner), traits::y(corner)),
+    screen.from_screen(traits::x(opposite_corner), traits::y(corner)),
+    screen.from_screen(traits::x(opposite_corner), traits::y(opposite_corner)),
+    screen.from_screen(traits::x(corner), traits::y(opposite_corner)),
+  };
+  return rasterize<T>(rectangle, orientation, coverage::overlap);
+}
+
+// same, restricted to the disk of given radius around the origin
+template <typename T = integers::base_type, typename Point2D, bool FlatTop>
+std::vector<basic_row_run<T>> visible_runs(
+  screen::ScreenTransformation<Point2D> const& screen,
+  Point2D const& corner,
+  Point2D const& opposite_corner,
+  Orientation<FlatTop> orientation,
+  disk_radius radius
+) {
+  auto runs = visible_runs<T>(screen, corner, opposite_corner, orientation);
+  for (auto & run : runs) run = intersection(run, disk_row(static_cast<T>(radius), run.r));
+  std::erase_if(runs, [](auto const& run){ return run.empty(); });
+  return runs;
+}
+
+/*
+visible part of a disk as sorted ranges of spiral indices.
+spiral order scatters a row over many rings, so the indices are sorted then merged:
+the cost grows with the number of visible cells.
+*/
+template <typename T = integers::base_type, typename Point2D, bool FlatTop>
+std::vector<index_range> visible_indices(
+  screen::ScreenTransformation<Point2D> const& screen,
+  Point2D const& corner,
+  Point2D const& opposite_corner,
+  Orientation<FlatTop> orientation,
+  disk_radius radius
+) {
+  std::vector<disk_index> indices;
+  for (auto const& run : visible_runs<T>(screen, corner, opposite_corner, orientation, radius)) {
+    for (auto const& p : run.points()) indices.push_back(details::disk_index_of(p - origin<T>));
+  }
+  std::ranges::sort(indices);
+
+  std::vector<index_range> ranges;
+  for (auto const i : indices) {
+    if (!ranges.empty() && ranges.back().end == i) ++ranges.back().end;
+    else ranges.push_back({i, i + 1});
+  }
+  return ranges;
+}
+
+} // namespace geometry::hex
+
+#endif
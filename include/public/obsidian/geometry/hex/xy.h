@@ -2,6 +2,7 @@
 #define OBSIDIAN_GEOMETRY_HEX_XY_H
 
 #include <obsidian/geometry/hex/coordinates.h>
+#include <obsidian/geometry/hex/neighbor.h>
 
 #include <type_traits>
 #include <array>
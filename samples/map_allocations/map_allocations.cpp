@@ -0,0 +1,83 @@
+#include <obsidian/geometry/core/map.h>
+#include <obsidian/geometry/core/memory.h>
+#include <obsidian/geometry/hex/disk.h>
+#include <obsidian/geometry/hex/hash.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// builds and drops many small scratch maps per tick, as AI or path finding would,
+// and counts the calls to the global operator new for each kind of storage.
+
+namespace {
+
+std::size_t allocations = 0;
+
+constexpr int ticks = 200;
+constexpr int maps_per_tick = 100;
+constexpr int entries_per_map = 64;
+
+using disk = geometry::hex::disk<int>;
+
+// same work for every storage: fill the maps of a tick, read them back
+template <typename Map, typename Make, typename EndTick>
+void run(char const* name, Make make, EndTick end_tick) {
+  disk const bounds{ 20 };
+  auto const before = allocations;
+  auto const start = std::chrono::steady_clock::now();
+
+  long long checksum = 0;
+  for (int tick = 0; tick < ticks; ++tick) {
+    {
+      for (int m = 0; m < maps_per_tick; ++m) {
+        Map map = make(bounds);
+        for (int e = 0; e < entries_per_map; ++e) {
+          map.set(static_cast<disk::index_type>((m * 31 + e * 17 + tick) % bounds.size()), e);
+        }
+        for (auto const& [i, value] : map.mappings()) checksum += static_cast<long long>(i) * value;
+      }
+    }
+    end_tick();
+  }
+
+  auto const elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+  std::printf("%-14s %10zu allocations %8.2f ms (checksum %lld)\n", name, allocations - before, elapsed.count(), checksum);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+  ++allocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// std::pmr::new_delete_resource goes through the aligned forms
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  ++allocations;
+  auto const a = static_cast<std::size_t>(alignment);
+  if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a)) return p;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+int main() {
+  using default_map = geometry::core::indexed_sparse_map<disk, int>;
+  using pmr_map = geometry::core::pmr::indexed_sparse_map<disk, int>;
+
+  std::printf("%d ticks of %d maps of %d entries\n", ticks, maps_per_tick, entries_per_map);
+
+  run<default_map>("std::allocator", [](disk const& b) { return default_map{ b }; }, []{});
+
+  geometry::core::arena arena{ 1 << 20 };
+  run<pmr_map>("arena", [&](disk const& b) { return pmr_map{ b, &arena }; }, [&]{ arena.reset(); });
+
+  run<pmr_map>("thread pool", [](disk const& b) { return pmr_map{ b, geometry::core::thread_node_pool() }; }, []{});
+}
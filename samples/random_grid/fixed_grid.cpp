@@ -7,12 +7,14 @@
 
 #include <obsidian/geometry/hex/hash.h>
 #include <obsidian/geometry/hex/xy.h>
+#include <obsidian/geometry/hex/ascii.h>
 
 #include <unordered_map>
 #include <random>
 #include <algorithm>
 
 #include <string>
+#include <charconv>
 
 #include <iostream>
 #include <iomanip>
@@ -48,107 +50,24 @@ std::ostream& operator << (std::ostream& o, hex::basic_vector<T> const& p) {
 
 using grid_type = grid<char>;
 
-using point = grid_type::point;
-using vector = grid_type::vector;
+using point = hex::basic_point<int>;
+using vector = hex::basic_vector<int>;
 
 
-std::ostream& print_offset(int n) {
-  for (int i = 0; i < n; ++i) std::cout << ' ';
-  return std::cout;
-}
-
-// formatter used as Formatter(stream, point) << "other text".
-// it shall output 9 chars
-template <typename Formatter>
-void print(grid_type const& g, Formatter formatter) {
-  constexpr auto width = 10;
-
-  constexpr char const* angle =   "+";
-  constexpr char const* hline =   "-----";
-
-  constexpr char const* trim    =   "+-----+";
-  constexpr char const* advance =  "       ";
-  constexpr char const* upper   = "/       \\";
-  constexpr char const* lower   ="\\       /";
-
-  constexpr vector right_shift{2, -1};
-  constexpr vector halfline_shift{1, -1};
-  
-  point ref{0, g.radius()};
-
-  // widening loop
-  for (auto line = 0; line <= g.radius(); ++line) {
-    auto const offset = (g.radius() - line) * (width - 2);
-
-    //A: line with labels
-    auto & labels = print_offset(offset+2) << trim;
-    for (auto i = 0; i < line; ++i) formatter(labels, ref + i * right_shift) << trim;
-    labels << '\n';
-    
-    //B: shape line
-    auto & shape = print_offset(offset+1) << upper;
-    for (auto i = 0; i < line; ++i) shape << advance << upper;
-    shape << '\n';
-
-    if (line > 0) ref|=-hex::neighborhood::i;
-  }
-  
-  // middle loop (<= so that e is done one more time)
-  for (auto line = 0; line <= g.radius(); ++line) {
-    //e: label first
-    auto & half_line = print_offset(0);
-    for (auto i = 0; i <= g.radius(); ++i) {
-      formatter(half_line << angle, ref + i * right_shift) << angle;
-      if (i < g.radius()) half_line << hline;
-    }
-    half_line << '\n';
-
-    if (line == g.radius()) break;
-    
-    //f: lower shape
-    auto & lower_shape = print_offset(1) << lower;
-    for (auto i = 0; i < g.radius(); ++i) lower_shape << advance << lower;
-    lower_shape << '\n';
-    
-    //g: label middle
-    auto & true_line = print_offset(2) << trim;
-    for (auto i = 0; i < g.radius(); ++i) formatter(true_line, ref + halfline_shift + i * right_shift) << trim;
-    true_line << '\n';
-    
-    //h: higher shape
-    auto & higher_shape = print_offset(1) << upper;
-    for (auto i = 0; i < g.radius(); ++i) higher_shape << advance << upper;
-    higher_shape << '\n';
-    
-    ref|=-hex::neighborhood::j;
-  }
-  
-  // narrowing loop
-  
-  for (auto line = 0; line <= g.radius(); ++line) {
-    ref|=-hex::neighborhood::k;
-    auto const offset = line * (width - 2);
-
-    //S: shape line
-    auto & shape = print_offset(offset+1) << lower;
-    for (auto i = 0; i < g.radius() - line; ++i) shape << advance << lower;
-    shape << '\n';
-
-    //T: line with labels
-    auto & labels = print_offset(offset+2) << trim;
-    for (auto i = 0; i < g.radius() - line; ++i) formatter(labels, ref + i * right_shift) << trim;
-    labels << '\n';
-  }
-}
-
 int main(int argc, char ** argv) {
   // print grids
-  auto printer = [](std::ostream & o, point const& p) -> std::ostream& {
-    return o << ' ' << std::right << std::setw(3) << p.q() << ',' << std::left << std::setw(3) << p.r() << ' ';
+  // " qqq,rrr " with q right and r left aligned, each cut to 4 chars
+  auto printer = [](point const& p, std::span<char, hex::ascii_slot> slot) {
+    char q[12], r[12];
+    auto const q_size = std::min<std::ptrdiff_t>(std::to_chars(std::begin(q), std::end(q), p.q()).ptr - q, 4);
+    auto const r_size = std::min<std::ptrdiff_t>(std::to_chars(std::begin(r), std::end(r), p.r()).ptr - r, 4);
+    std::copy(q, q + q_size, slot.begin() + (4 - q_size));
+    slot[4] = ',';
+    std::copy(r, r + r_size, slot.begin() + 5);
   };
   
-  for (grid_type::radius_type i = 0; i <= static_cast<grid_type::radius_type>(3); ++i) {
-    print(grid_type{i}, printer);
+  for (hex::disk_radius i = 0; i <= 3; ++i) {
+    std::cout << hex::render_ascii(i, printer);
   }
   
   std::cout << "vectors in disk\n";
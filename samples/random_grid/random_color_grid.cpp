@@ -6,6 +6,8 @@
 #include <obsidian/geometry/hex/disk.h>
 
 #include <obsidian/geometry/hex/hash.h>
+#include <obsidian/geometry/core/sampling.h>
+#include <obsidian/geometry/hex/viewport.h>
 
 #include <SFML/Graphics.hpp>
 
@@ -66,12 +68,11 @@ int main(int argc, char ** argv) {
   // Will be used to obtain a seed for the random number engine
   std::random_device rd;
   std::mt19937 gen(rd());
-  std::uniform_int_distribution<std::size_t> index(0, map.area());
   std::uniform_int_distribution<sf::Uint8> colors(0, 12);
   
-  while (map.size() < number) {
+  for (auto const i : geometry::core::sample_indices<std::size_t>(map.area(), number, gen)) {
     map.set(
-      map.position_by_index(index(gen)),
+      map.position_by_index(i),
       sf::Color(135+10*colors(gen), 135+10*colors(gen), 135+10*colors(gen))
     );
   }
@@ -106,9 +107,9 @@ int main(int argc, char ** argv) {
             window.close();
           } else if (event.key.code == sf::Keyboard::Space) {
             map.clear();
-            while (map.size() < number) {
+            for (auto const i : geometry::core::sample_indices<std::size_t>(map.area(), number, gen)) {
               map.set(
-                map.position_by_index(index(gen)),
+                map.position_by_index(i),
                 sf::Color(135+10*colors(gen), 135+10*colors(gen), 135+10*colors(gen))
               );
             }
@@ -117,11 +118,22 @@ int main(int argc, char ** argv) {
       }
 
       window.clear(sf::Color::Black);
-      for(auto const& p : map.surface()) {
-        grid_cell.setPosition(
-          screener(hex::FlatTop::to_xy(p))
-        );
-        window.draw(grid_cell);
+      // only the cells inside the window
+      auto const window_size = window.getSize();
+      auto const visible = hex::visible_runs(
+        screener,
+        {0.f, 0.f},
+        {static_cast<float>(window_size.x), static_cast<float>(window_size.y)},
+        hex::FlatTop{},
+        map.bounds().radius()
+      );
+      for (auto const& run : visible) {
+        for (auto const& p : run.points()) {
+          grid_cell.setPosition(
+            screener(hex::FlatTop::to_xy(p))
+          );
+          window.draw(grid_cell);
+        }
       }
       
       for (auto const& [pos, color] : map.values()) {
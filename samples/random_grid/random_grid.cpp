@@ -6,6 +6,7 @@
 #include <obsidian/geometry/hex/disk.h>
 
 #include <obsidian/geometry/hex/hash.h>
+#include <obsidian/geometry/core/sampling.h>
 
 #include <SFML/Graphics.hpp>
 
@@ -66,12 +67,11 @@ int main(int argc, char ** argv) {
   // Will be used to obtain a seed for the random number engine
   std::random_device rd;
   std::mt19937 gen(rd());
-  std::uniform_int_distribution<std::size_t> index(0, map.area());
   std::uniform_int_distribution<sf::Uint8> colors(0, 12);
   
-  while (map.size() < number) {
+  for (auto const i : geometry::core::sample_indices<std::size_t>(map.area(), number, gen)) {
     map.set(
-      map.position_by_index(index(gen)),
+      map.position_by_index(i),
       sf::Color(135+10*colors(gen), 135+10*colors(gen), 135+10*colors(gen))
     );
   }
@@ -106,9 +106,9 @@ int main(int argc, char ** argv) {
             window.close();
           } else if (event.key.code == sf::Keyboard::Space) {
             map.clear();
-            while (map.size() < number) {
+            for (auto const i : geometry::core::sample_indices<std::size_t>(map.area(), number, gen)) {
               map.set(
-                map.position_by_index(index(gen)),
+                map.position_by_index(i),
                 sf::Color(135+10*colors(gen), 135+10*colors(gen), 135+10*colors(gen))
               );
             }
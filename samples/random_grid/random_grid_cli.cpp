@@ -6,7 +6,9 @@
 #include <obsidian/geometry/hex/disk.h>
 
 #include <obsidian/geometry/hex/hash.h>
+#include <obsidian/geometry/core/sampling.h>
 #include <obsidian/geometry/hex/xy.h>
+#include <obsidian/geometry/hex/ascii.h>
 
 #include <unordered_map>
 #include <random>
@@ -48,102 +50,13 @@ std::ostream& operator << (std::ostream& o, hex::basic_vector<T> const& p) {
 
 using grid_type = grid<char>;
 
-using point = grid_type::point;
-using vector = grid_type::vector;
+using point = hex::basic_point<int>;
+using vector = hex::basic_vector<int>;
 
 
-std::ostream& print_offset(int n) {
-  for (int i = 0; i < n; ++i) std::cout << ' ';
-  return std::cout;
-}
-
-// formatter used as Formatter(stream, point) << "other text".
-// it shall output 9 chars
-template <typename Formatter>
-void print(grid_type const& g, Formatter formatter) {
-  constexpr auto width = 10;
-
-  constexpr char const* angle =   "+";
-  constexpr char const* hline =   "-----";
-
-  constexpr char const* trim    =   "+-----+";
-  constexpr char const* advance =  "       ";
-  constexpr char const* upper   = "/       \\";
-  constexpr char const* lower   ="\\       /";
-
-  constexpr vector right_shift{2, -1};
-  constexpr vector halfline_shift{1, -1};
-  
-  point ref{0, g.radius()};
-
-  // widening loop
-  for (auto line = 0; line <= g.radius(); ++line) {
-    auto const offset = (g.radius() - line) * (width - 2);
-
-    //A: line with labels
-    auto & labels = print_offset(offset+2) << trim;
-    for (auto i = 0; i < line; ++i) formatter(labels, ref + i * right_shift) << trim;
-    labels << '\n';
-    
-    //B: shape line
-    auto & shape = print_offset(offset+1) << upper;
-    for (auto i = 0; i < line; ++i) shape << advance << upper;
-    shape << '\n';
-
-    if (line > 0) ref|=-hex::neighborhood::i;
-  }
-  
-  // middle loop (<= so that e is done one more time)
-  for (auto line = 0; line <= g.radius(); ++line) {
-    //e: label first
-    auto & half_line = print_offset(0);
-    for (auto i = 0; i <= g.radius(); ++i) {
-      formatter(half_line << angle, ref + i * right_shift) << angle;
-      if (i < g.radius()) half_line << hline;
-    }
-    half_line << '\n';
-
-    if (line == g.radius()) break;
-    
-    //f: lower shape
-    auto & lower_shape = print_offset(1) << lower;
-    for (auto i = 0; i < g.radius(); ++i) lower_shape << advance << lower;
-    lower_shape << '\n';
-    
-    //g: label middle
-    auto & true_line = print_offset(2) << trim;
-    for (auto i = 0; i < g.radius(); ++i) formatter(true_line, ref + halfline_shift + i * right_shift) << trim;
-    true_line << '\n';
-    
-    //h: higher shape
-    auto & higher_shape = print_offset(1) << upper;
-    for (auto i = 0; i < g.radius(); ++i) higher_shape << advance << upper;
-    higher_shape << '\n';
-    
-    ref|=-hex::neighborhood::j;
-  }
-  
-  // narrowing loop
-  
-  for (auto line = 0; line <= g.radius(); ++line) {
-    ref|=-hex::neighborhood::k;
-    auto const offset = line * (width - 2);
-
-    //S: shape line
-    auto & shape = print_offset(offset+1) << lower;
-    for (auto i = 0; i < g.radius() - line; ++i) shape << advance << lower;
-    shape << '\n';
-
-    //T: line with labels
-    auto & labels = print_offset(offset+2) << trim;
-    for (auto i = 0; i < g.radius() - line; ++i) formatter(labels, ref + i * right_shift) << trim;
-    labels << '\n';
-  }
-}
-
 int main(int argc, char ** argv) {
   constexpr unsigned int minimal_radius = 1;
-  constexpr unsigned int maximal_radius = 7;
+  constexpr unsigned int maximal_radius = 200;
 
   if (argc < 2) {
     std::cout << "no radius provided." << std::endl;
@@ -152,18 +65,18 @@ int main(int argc, char ** argv) {
   }
   
   auto radius = read_int(argv[1]);
-  radius = std::clamp(minimal_radius, radius, maximal_radius);
+  radius = std::clamp(radius, minimal_radius, maximal_radius);
   
   unsigned int number = radius * 2;
   if (argc > 2) {
     auto n = read_int(argv[2]);
     std::cout << "asked for " << n << " values" << std::endl;
-    number = std::clamp(radius * 2, n, 3 * radius * (radius-1));
+    number = std::clamp<unsigned int>(n, 1, hex::disk_size(radius));
   }
   
   std::cout << "preparing a disk of radius " << radius << std::endl;
 
-  grid_type map{radius};
+  grid_type map{hex::disk<int>{radius}};
 
 
   std::cout << "filling " << number << " random letters" << std::endl;
@@ -171,11 +84,10 @@ int main(int argc, char ** argv) {
   // Will be used to obtain a seed for the random number engine
   std::random_device rd;
   std::mt19937 gen(rd());
-  std::uniform_int_distribution<std::size_t> index(0, map.area());
-  std::uniform_int_distribution<char> letters('a', 'z');
+  std::uniform_int_distribution<int> letters('a', 'z');
   
-  while (map.size() < number) {
-    map.set( map.position_by_index(index(gen)), letters(gen) );
+  for (auto const i : geometry::core::sample_indices<std::size_t>(map.area(), number, gen)) {
+    map.set( i, static_cast<char>(letters(gen)) );
   }
   
   std::cout << "map filled with " << map.size() << " values.\n";
@@ -187,8 +99,8 @@ int main(int argc, char ** argv) {
   
   // print grid
   
-  print(map, [&map](std::ostream & o, point const& p) -> std::ostream& {
-    return o << "    " << map.get(p, ' ') << "    ";
+  std::cout << hex::render_ascii(map.bounds().radius(), [&map](point const& p, std::span<char, hex::ascii_slot> slot) {
+    if (auto const v = map.optional(p)) slot[4] = *v;
   });
   
   /*
@@ -6,6 +6,8 @@
 #include <obsidian/geometry/hex/disk.h>
 
 #include <obsidian/geometry/hex/hash.h>
+#include <obsidian/geometry/core/sampling.h>
+#include <obsidian/geometry/hex/viewport.h>
 
 #include <SFML/Graphics.hpp>
 
@@ -73,14 +75,12 @@ public:
     m_map.clear();
     m_map.set(0, sol);
 
-    while (m_map.size() < m_planets) {
-      auto i = index_distr(m_gen);
-      // don't replace sol;
-      if (m_map.contains(i)) continue;
-
+    // planets anywhere but on sol, at index 0
+    auto const planets = m_planets > 0 ? m_planets - 1 : 0;
+    for (auto const i : geometry::core::sample_indices<index_type>(m_map.area() - 1, planets, m_gen)) {
       std::ostringstream name;
       name << "Sol " << m_map.size();
-      set(i, {
+      set(i + 1, {
         name.str(),
         Stellar::sizes::huge,
         sf::Color(105+10*colors(m_gen), 105+10*colors(m_gen), 105+10*colors(m_gen))
@@ -114,7 +114,6 @@ private:
   Stellar sol{"Sol", Stellar::sizes::huge, { 255, 255, 120 }};
   index_type m_planets;
   
-  std::uniform_int_distribution<std::size_t> index_distr{ static_cast<index_type>(0), m_map.area() };
   std::uniform_int_distribution<sf::Uint8> colors { 0, 12 };
   std::mt19937 & m_gen;
 };
@@ -197,9 +196,20 @@ int main(int argc, char ** argv) {
       
       window.draw(txt_title);
       
-      for(auto const& pos : map.positions()) {
-        grid_cell.setPosition( screener(hex::FlatTop::to_xy(pos)) );
-        window.draw(grid_cell);
+      // only the cells inside the window
+      auto const window_size = window.getSize();
+      auto const visible = hex::visible_runs(
+        screener,
+        {0.f, 0.f},
+        {static_cast<float>(window_size.x), static_cast<float>(window_size.y)},
+        hex::FlatTop{},
+        map.radius()
+      );
+      for (auto const& run : visible) {
+        for (auto const& pos : run.points()) {
+          grid_cell.setPosition( screener(hex::FlatTop::to_xy(pos)) );
+          window.draw(grid_cell);
+        }
       }
       
       for (int i = 0; auto const& [pos, stellar] : map.values()) {